@@ -19,7 +19,10 @@
 #include "Engine/Content/Storage/FlaxFile.h"
 #include "Engine/Particles/ParticleEmitter.h"
 #include "Engine/Utilities/Encryption.h"
+#include "Engine/Level/Prefabs/Prefab.h"
+#include "Engine/Level/Scene/SceneAsset.h"
 #include "Engine/Serialization/JsonWriters.h"
+#include "Engine/Serialization/JsonBinary.h"
 #include "Engine/Serialization/FileWriteStream.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #include "Engine/Core/Config/PlatformSettings.h"
@@ -353,7 +356,25 @@ bool CookAssetsStep::ProcessDefaultAsset(AssetCookData& options)
         // Store json data in the first chunk
         auto chunk = New<FlaxChunk>();
         chunk->Flags = FlaxChunkFlags::CompressedLZ4; // Compress json data (internal storage layer will handle it)
-        chunk->Data.Copy((byte*)buffer.GetString(), (int32)buffer.GetSize());
+        if (dynamic_cast<SceneAsset*>(options.Asset) || dynamic_cast<Prefab*>(options.Asset))
+        {
+            // Scenes and prefabs use binary json to skip text parsing and strings copies when loading the game
+            rapidjson_flax::Document document;
+            document.Parse(buffer.GetString(), buffer.GetSize());
+            if (document.HasParseError())
+            {
+                LOG(Error, "Failed to parse json asset \'{0}\'", options.Asset->ToString());
+                Delete(chunk);
+                return true;
+            }
+            MemoryWriteStream stream((uint32)buffer.GetSize());
+            JsonBinary::Write(stream, document);
+            chunk->Data.Copy(stream.GetHandle(), stream.GetPosition());
+        }
+        else
+        {
+            chunk->Data.Copy((byte*)buffer.GetString(), (int32)buffer.GetSize());
+        }
         options.InitData.Header.Chunks[0] = chunk;
 
         return false;
@@ -68,6 +68,7 @@ AnimContinuousEvent::AnimContinuousEvent(const SpawnParams& params)
 bool AnimationsService::Init()
 {
     Animations::System = New<AnimationsSystem>();
+    Animations::System->AsyncExecute = true;
     Engine::UpdateGraph->AddSystem(Animations::System);
     return false;
 }
@@ -100,7 +100,10 @@ Asset::LoadResult SceneAnimation::load()
     const auto chunk0 = GetChunk(0);
     if (chunk0 == nullptr || chunk0->IsMissing())
         return LoadResult::MissingDataChunk;
-    _data.Swap(chunk0->Data);
+    if (chunk0->Data.IsAllocated())
+        _data.Swap(chunk0->Data);
+    else
+        _data.Copy(chunk0->Data); // Chunk references the memory-mapped package that can be closed
     MemoryReadStream stream(_data.Get(), _data.Length());
     _runtimeData.SetPosition(0);
 
@@ -1084,6 +1084,16 @@ void ModelBase::SetupMaterialSlots(int32 slotsCount)
         MaterialSlots[i].Name = String::Format(TEXT("Material {0}"), i + 1);
 }
 
+uint64 ModelBase::GetResidencyMemoryUsage(int32 residency) const
+{
+    // Estimate using the size of the LODs data in the storage (the lowest quality LODs are loaded first)
+    uint64 result = 0;
+    const int32 lodsCount = GetLODsCount();
+    for (int32 lodIndex = Math::Max(lodsCount - residency, 0); lodIndex < lodsCount; lodIndex++)
+        result += GetChunkSize(MODEL_LOD_TO_CHUNK_INDEX(lodIndex));
+    return result;
+}
+
 MaterialSlot* ModelBase::GetSlot(const StringView& name)
 {
     MaterialSlot* result = nullptr;
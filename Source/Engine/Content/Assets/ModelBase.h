@@ -127,4 +127,8 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API ModelBase : public BinaryAsset
     /// Gets the meshes for a particular LOD index.
     /// </summary>
     virtual void GetMeshes(Array<MeshBase*>& meshes, int32 lodIndex = 0) = 0;
+
+public:
+    // [StreamableResource]
+    uint64 GetResidencyMemoryUsage(int32 residency) const override;
 };
@@ -14,6 +14,8 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Config/Settings.h"
 #include "Engine/Serialization/JsonTools.h"
+#include "Engine/Serialization/JsonBinary.h"
+#include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Serialization/JsonWriters.h"
 #include "Engine/Content/Factories/JsonAssetFactory.h"
 #include "Engine/Core/Cache.h"
@@ -261,15 +263,24 @@ Asset::LoadResult JsonAssetBase::loadAsset()
     auto& data = chunk->Data;
 #endif
 
-    // Parse json document
+    // Parse json document (cooked scenes and prefabs use binary format)
+    if (JsonBinary::IsBinary(data.Get(), data.Length()))
     {
-        PROFILE_CPU_NAMED("Json.Parse");
-        Document.Parse(data.Get<char>(), data.Length());
+        MemoryReadStream stream(data.Get(), data.Length());
+        if (JsonBinary::Read(stream, Document))
+            return LoadResult::CannotLoadData;
     }
-    if (Document.HasParseError())
+    else
     {
-        Log::JsonParseException(Document.GetParseError(), Document.GetErrorOffset());
-        return LoadResult::CannotLoadData;
+        {
+            PROFILE_CPU_NAMED("Json.Parse");
+            Document.Parse(data.Get<char>(), data.Length());
+        }
+        if (Document.HasParseError())
+        {
+            Log::JsonParseException(Document.GetParseError(), Document.GetErrorOffset());
+            return LoadResult::CannotLoadData;
+        }
     }
 
     // Gather information from the header
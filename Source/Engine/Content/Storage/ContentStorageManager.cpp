@@ -52,6 +52,7 @@ namespace
 ContentStorageService ContentStorageServiceInstance;
 
 TimeSpan ContentStorageManager::UnusedDataChunksLifetime = TimeSpan::FromSeconds(10);
+bool ContentStorageManager::UseMemoryMappedPackages = false;
 
 FlaxStorageReference ContentStorageManager::GetStorage(const StringView& path, bool loadIt)
 {
@@ -245,6 +246,7 @@ void ContentStorageService::Dispose()
     Packages.ClearDelete();
     StorageMap.Clear();
     ASSERT(Files.IsEmpty() && Packages.IsEmpty());
+    FlaxStorage::ReleaseScratchBuffers();
     SAFE_DELETE(System);
 }
 
@@ -19,6 +19,11 @@ class FLAXENGINE_API ContentStorageManager
     /// </summary>
     static TimeSpan UnusedDataChunksLifetime;
 
+    /// <summary>
+    /// Enables memory-mapping of the packages files (cooked game content). Uncompressed chunks reference the mapped file data directly instead of copying it into the memory and the mapped pages are shared with the other processes that use the same files. Used only on 64-bit platforms that support files mapping.
+    /// </summary>
+    static bool UseMemoryMappedPackages;
+
 public:
     /// <summary>
     /// Gets the assets data storage container.
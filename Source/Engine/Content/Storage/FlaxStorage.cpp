@@ -12,6 +12,7 @@
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/ThreadLocal.h"
 #if USE_EDITOR
 #include "Engine/Serialization/JsonWriter.h"
 #include "Engine/Serialization/JsonWriters.h"
@@ -20,6 +21,52 @@
 #endif
 #include <ThirdParty/LZ4/lz4.h>
 
+// Maximum size of the per-thread buffer for compressed chunks data kept between loads (larger buffers are released after use)
+#define FLAX_STORAGE_SCRATCH_BUFFER_MAX_SIZE (16 * 1024 * 1024)
+
+namespace
+{
+    ThreadLocal<Array<byte>*> ScratchBuffers;
+
+    Array<byte>& GetScratchBuffer()
+    {
+        auto& buffer = ScratchBuffers.Get();
+        if (buffer == nullptr)
+            buffer = New<Array<byte>>();
+        return *buffer;
+    }
+
+    bool ReadFileAt(File* file, byte* data, uint32 size, uint32 position)
+    {
+        // Positional reads can return less data than requested
+        while (size != 0)
+        {
+            uint32 bytesRead;
+            if (file->ReadAt(data, size, position, &bytesRead) || bytesRead == 0)
+                return true;
+            data += bytesRead;
+            position += bytesRead;
+            size -= bytesRead;
+        }
+        return false;
+    }
+
+    bool ReadChunkData(File* file, byte* data, uint32 size, uint32 position)
+    {
+        if (!ReadFileAt(file, data, size, position))
+            return false;
+
+        // Sometimes reading fails in release builds (eg. file handle gets invalid), retry a few times to ensure the content loads
+        for (int32 retry = 0; retry < 5; retry++)
+        {
+            Platform::Sleep(50);
+            if (!ReadFileAt(file, data, size, position))
+                return false;
+        }
+        return true;
+    }
+}
+
 int32 AssetHeader::GetChunksCount() const
 {
     int32 result = 0;
@@ -233,6 +280,8 @@ FlaxStorage::~FlaxStorage()
     CHECK(_refCount == 0);
     ASSERT(_chunks.IsEmpty());
 
+    UnmapFile();
+
 #if USE_EDITOR
     // Ensure to close any outstanding file handles to prevent file locking in case it failed to load
     Array<FileReadStream*> streams;
@@ -268,7 +317,11 @@ uint32 FlaxStorage::GetMemoryUsage() const
 {
     uint32 result = sizeof(FlaxStorage);
     for (int32 i = 0; i < _chunks.Count(); i++)
-        result += _chunks[i]->Data.Length();
+    {
+        // Skip chunks that reference the memory-mapped file
+        if (_chunks[i]->Data.IsAllocated())
+            result += _chunks[i]->Data.Length();
+    }
     return result;
 }
 
@@ -643,72 +696,73 @@ bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
 
     LockChunks();
 
-    // Open file
+    // Open file (each thread uses own file handle and reads chunks at their location so many threads can load chunks at once)
     auto stream = OpenFile();
     bool failed = stream == nullptr;
     if (!failed)
     {
-        // Seek
-        stream->SetPosition(chunk->LocationInFile.Address);
-
-        if (stream->HasError())
+        File* file = stream->GetFile();
+        const uint32 address = chunk->LocationInFile.Address;
+        uint32 size = chunk->LocationInFile.Size;
+        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
         {
-            // Sometimes stream->HasError() from setposition. result in a crash or missing media in release (stream _file._handle = nullptr).
-            // When retrying, it looks like it works and we can continue. We need this to success.
-
-            for (int retry = 0; retry < 5; retry++)
+            // Compressed (original size int followed by the compressed data)
+            auto& tmpBuf = GetScratchBuffer();
+            tmpBuf.Resize(size, false);
+            failed = ReadChunkData(file, tmpBuf.Get(), size, address);
+            if (!failed)
             {
-                Platform::Sleep(50);
-                stream = OpenFile();
-                failed = stream == nullptr;
-                if (!failed)
+                size -= sizeof(int32); // Don't count original size int
+                int32 originalSize;
+                Platform::MemoryCopy(&originalSize, tmpBuf.Get(), sizeof(int32));
+
+                // Decompress data
+                PROFILE_CPU_NAMED("DecompressLZ4");
+                chunk->Data.Allocate(originalSize);
+                const int32 res = LZ4_decompress_safe((const char*)tmpBuf.Get() + sizeof(int32), chunk->Data.Get<char>(), size, originalSize);
+                if (res <= 0)
                 {
-                    stream->SetPosition(chunk->LocationInFile.Address);
+                    chunk->Data.Release();
+                    LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", ToString(), res);
+                    failed = true;
+                }
+                else
+                {
+                    chunk->Data.SetLength(res);
                 }
-                if (!stream->HasError())
-                    break;
             }
+            else
+            {
+                LOG(Warning, "Cannot read chunk from {0}.", ToString());
+            }
+            if (tmpBuf.Capacity() > FLAX_STORAGE_SCRATCH_BUFFER_MAX_SIZE)
+                tmpBuf.SetCapacity(0, false);
         }
-
-        if (stream->HasError())
+        else if (const byte* mappedData = MapFile())
         {
-            failed = true;
-            UnlockChunks();
-            LOG(Warning, "SetPosition failed on chunk {0}.", ToString());
-            return failed;
+            // Raw data from the memory-mapped file (chunk references the file pages without copying them)
+            failed = (uint64)address + size > _mappedSize;
+            if (failed)
+                LOG(Warning, "Cannot read chunk from {0}.", ToString());
+            else
+                chunk->Data.Link(mappedData + address, (int32)size);
         }
-
-        // Load data
-        auto size = chunk->LocationInFile.Size;
-        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+        else
         {
-            // Compressed
-            size -= sizeof(int32); // Don't count original size int
-            int32 originalSize;
-            stream->ReadInt32(&originalSize);
-            Array<byte> tmpBuf;
-            tmpBuf.Resize(size); // TODO: maybe use thread local or content loading pool with sharable temp buffers for the decompression?
-            stream->ReadBytes(tmpBuf.Get(), size);
-
-            // Decompress data
-            PROFILE_CPU_NAMED("DecompressLZ4");
-            chunk->Data.Allocate(originalSize);
-            const int32 res = LZ4_decompress_safe((const char*)tmpBuf.Get(), chunk->Data.Get<char>(), size, originalSize);
-            if (res <= 0)
+            // Raw data
+            chunk->Data.Allocate(size);
+            failed = ReadChunkData(file, chunk->Data.Get(), size, address);
+            if (failed)
             {
-                UnlockChunks();
-                LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", ToString(), res);
-                return true;
+                chunk->Data.Release();
+                LOG(Warning, "Cannot read chunk from {0}.", ToString());
             }
-            chunk->Data.SetLength(res);
         }
-        else
+        if (!failed)
         {
-            // Raw data
-            chunk->Data.Read(stream, size);
+            ASSERT(chunk->IsLoaded());
+            chunk->RegisterUsage();
         }
-        ASSERT(chunk->IsLoaded());
-        chunk->RegisterUsage();
     }
 
     UnlockChunks();
@@ -1334,6 +1388,57 @@ FileReadStream* FlaxStorage::OpenFile()
     return stream;
 }
 
+const byte* FlaxStorage::MapFile()
+{
+#if PLATFORM_64BITS
+    if (!ContentStorageManager::UseMemoryMappedPackages || !IsPackage())
+        return nullptr;
+    ScopeLock lock(_loadLocker);
+    if (_mappedData == nullptr && !_mappingFailed)
+    {
+        // Map the whole file once, chunks loaded later reference it until the file handles get closed
+        PROFILE_CPU();
+        _mappedFile = File::Open(_path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+        if (_mappedFile)
+            _mappedData = _mappedFile->Map(_mappedSize);
+        if (_mappedData == nullptr)
+        {
+            // Fallback to reading chunks data from file
+            LOG(Warning, "Cannot map Flax Storage file \'{0}\'.", _path);
+            _mappingFailed = true;
+            if (_mappedFile)
+            {
+                Delete(_mappedFile);
+                _mappedFile = nullptr;
+            }
+        }
+    }
+    return _mappedData;
+#else
+    return nullptr;
+#endif
+}
+
+void FlaxStorage::UnmapFile()
+{
+    ScopeLock lock(_loadLocker);
+    if (_mappedData == nullptr)
+        return;
+
+    // Unload chunks that reference the mapped memory (chunks are not locked so they will be loaded again on use)
+    for (FlaxChunk* chunk : _chunks)
+    {
+        if (!chunk->Data.IsAllocated() && chunk->Data.Get() >= _mappedData && chunk->Data.Get() < _mappedData + _mappedSize)
+            chunk->Unload();
+    }
+
+    _mappedFile->Unmap(_mappedData, _mappedSize);
+    Delete(_mappedFile);
+    _mappedFile = nullptr;
+    _mappedData = nullptr;
+    _mappedSize = 0;
+}
+
 bool FlaxStorage::CloseFileHandles()
 {
     PROFILE_CPU();
@@ -1375,9 +1480,22 @@ bool FlaxStorage::CloseFileHandles()
             Delete(stream);
     }
     _file.Clear();
+    UnmapFile();
     return false;
 }
 
+void FlaxStorage::ReleaseScratchBuffers()
+{
+    Array<Array<byte>*> buffers;
+    ScratchBuffers.GetValues(buffers);
+    for (Array<byte>* buffer : buffers)
+    {
+        if (buffer)
+            Delete(buffer);
+    }
+    ScratchBuffers.Clear();
+}
+
 void FlaxStorage::Dispose()
 {
     if (IsDisposed())
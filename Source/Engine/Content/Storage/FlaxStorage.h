@@ -95,6 +95,10 @@ class FLAXENGINE_API FlaxStorage : public Object
     // Storage
     ThreadLocal<FileReadStream*> _file;
     Array<FlaxChunk*> _chunks;
+    File* _mappedFile = nullptr;
+    const byte* _mappedData = nullptr;
+    uint32 _mappedSize = 0;
+    bool _mappingFailed = false;
 
     // Metadata
     uint32 _version;
@@ -126,7 +130,7 @@ class FLAXENGINE_API FlaxStorage : public Object
 
 public:
     /// <summary>
-    /// Locks the storage chunks data to prevent disposing them. Also ensures that file handles won't be closed while chunks are locked.
+    /// Locks the storage chunks data to prevent disposing them. Also ensures that file handles (and the memory-mapped file that chunks can reference) won't be closed while chunks are locked.
     /// </summary>
     FORCE_INLINE void LockChunks()
     {
@@ -406,6 +410,11 @@ class FLAXENGINE_API FlaxStorage : public Object
     /// </summary>
     bool CloseFileHandles();
 
+    /// <summary>
+    /// Releases the per-thread buffers used for the compressed chunks loading.
+    /// </summary>
+    static void ReleaseScratchBuffers();
+
     /// <summary>
 	/// Releases storage resources and closes handle to the file.
 	/// </summary>
@@ -486,5 +495,7 @@ class FLAXENGINE_API FlaxStorage : public Object
     void AddChunk(FlaxChunk* chunk);
     virtual void AddEntry(Entry& e) = 0;
     FileReadStream* OpenFile();
+    const byte* MapFile();
+    void UnmapFile();
     virtual bool GetEntry(const Guid& id, Entry& e) = 0;
 };
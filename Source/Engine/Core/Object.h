@@ -16,6 +16,8 @@ enum class ObjectFlags : uint32
     IsManagedType = 1 << 3,
     IsDuringPlay = 1 << 4,
     IsCustomScriptingType = 1 << 5,
+    // Scene object has to be deserialized on the main thread during scene loading (eg. it accesses other objects data when linked to the parent).
+    NoAsyncDeserialize = 1 << 6,
 };
 
 DECLARE_ENUM_OPERATORS(ObjectFlags);
@@ -1232,7 +1232,7 @@ void Foliage::Draw(RenderContextBatch& renderContextBatch)
         _renderContextBatch = &renderContextBatch;
         Function<void(int32)> func;
         func.Bind<Foliage, &Foliage::DrawFoliageJob>(this);
-        const uint64 waitLabel = JobSystem::Dispatch(func, FoliageTypes.Count());
+        const uint64 waitLabel = JobSystem::Dispatch(func, FoliageTypes.Count(), JobPriority::High);
         renderContextBatch.WaitLabels.Add(waitLabel);
         return;
     }
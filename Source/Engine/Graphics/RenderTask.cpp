@@ -226,8 +226,8 @@ void AddActorToSceneRendering(SceneRendering* s, Actor* a)
 {
     if (a && a->IsActiveInHierarchy())
     {
-        int32 key = -1;
-        s->AddActor(a, key);
+        // Custom actors scene is cleared and rebuilt every frame so actors keys are not tracked
+        s->AddActor(a);
         for (Actor* child : a->Children)
             AddActorToSceneRendering(s, child);
     }
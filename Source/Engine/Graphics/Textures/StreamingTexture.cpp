@@ -166,6 +166,17 @@ int32 StreamingTexture::GetAllocatedResidency() const
     return _texture->MipLevels();
 }
 
+uint64 StreamingTexture::GetResidencyMemoryUsage(int32 residency) const
+{
+    if (residency <= 0 || !IsInitialized())
+        return 0;
+    residency = Math::Min(residency, TotalMipLevels());
+    const int32 mipIndex = TotalMipLevels() - residency;
+    const int32 width = Math::Max(TotalWidth() >> mipIndex, 1);
+    const int32 height = Math::Max(TotalHeight() >> mipIndex, 1);
+    return RenderTools::CalculateTextureMemoryUsage(_header.Format, width, height, residency) * TotalArraySize();
+}
+
 bool StreamingTexture::CanBeUpdated() const
 {
     // Streaming Texture cannot be updated if:
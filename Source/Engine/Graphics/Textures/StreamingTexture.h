@@ -170,6 +170,7 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     int32 GetMaxResidency() const override;
     int32 GetCurrentResidency() const override;
     int32 GetAllocatedResidency() const override;
+    uint64 GetResidencyMemoryUsage(int32 residency) const override;
     bool CanBeUpdated() const override;
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
@@ -1041,11 +1041,14 @@ void Actor::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
                 }
                 else
                 {
+                    // Scene objects can be deserialized on multiple threads at once (see Level::loadScene)
+                    Level::ScenesLock.Lock();
                     if (_parent)
                         _parent->Children.RemoveKeepOrder(this);
                     _parent = parent;
                     if (_parent)
                         _parent->Children.Add(this);
+                    Level::ScenesLock.Unlock();
                     OnParentChanged();
                 }
             }
@@ -12,6 +12,7 @@
 Ragdoll::Ragdoll(const SpawnParams& params)
     : Actor(params)
 {
+    Flags |= ObjectFlags::NoAsyncDeserialize; // Binds to the parent animated model events when linked to it
 }
 
 float Ragdoll::GetTotalMass() const
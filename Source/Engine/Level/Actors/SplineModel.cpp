@@ -26,6 +26,7 @@ SplineModel::SplineModel(const SpawnParams& params)
     : ModelInstanceActor(params)
 {
     _drawCategory = SceneRendering::SceneDrawAsync;
+    Flags |= ObjectFlags::NoAsyncDeserialize; // Reads the parent spline data when linked to it
     Model.Changed.Bind<SplineModel, &SplineModel::OnModelChanged>(this);
     Model.Loaded.Bind<SplineModel, &SplineModel::OnModelLoaded>(this);
 }
@@ -32,6 +32,8 @@
 #include "Engine/Scripting/Scripting.h"
 #include "Engine/Scripting/BinaryModule.h"
 #include "Engine/Serialization/JsonTools.h"
+#include "Engine/Serialization/JsonBinary.h"
+#include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Serialization/JsonWriters.h"
 #include "Prefabs/Prefab.h"
@@ -125,6 +127,7 @@ namespace LevelImpl
     bool saveScene(Scene* scene, rapidjson_flax::StringBuffer& outBuffer, JsonWriter& writer);
     bool spawnActor(Actor* actor, Actor* parent);
     bool deleteActor(Actor* actor);
+    void restoreLoadOrder(SceneObject** objects, Actor* const* prevParents, int32 count);
 }
 
 using namespace LevelImpl;
@@ -838,16 +841,25 @@ bool Level::loadScene(const BytesContainer& sceneData, Scene** outScene)
         return true;
     }
 
-    // Parse scene JSON file
+    // Parse scene JSON file (or binary json of the cooked scene)
     rapidjson_flax::Document document;
+    if (JsonBinary::IsBinary(sceneData.Get(), sceneData.Length()))
     {
-        PROFILE_CPU_NAMED("Json.Parse");
-        document.Parse(sceneData.Get<char>(), sceneData.Length());
+        MemoryReadStream stream(sceneData.Get(), sceneData.Length());
+        if (JsonBinary::Read(stream, document))
+            return true;
     }
-    if (document.HasParseError())
+    else
     {
-        Log::JsonParseException(document.GetParseError(), document.GetErrorOffset());
-        return true;
+        {
+            PROFILE_CPU_NAMED("Json.Parse");
+            document.Parse(sceneData.Get<char>(), sceneData.Length());
+        }
+        if (document.HasParseError())
+        {
+            Log::JsonParseException(document.GetParseError(), document.GetErrorOffset());
+            return true;
+        }
     }
 
     ScopeLock lock(ScenesLock);
@@ -945,23 +957,25 @@ bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** ou
         if (context.Async)
         {
             ScenesLock.Unlock(); // Unlock scenes from Main Thread so Job Threads can use it to safely setup actors hierarchy (see Actor::Deserialize)
-            JobSystem::Execute([&](int32 i)
+            JobSystem::ParallelFor(1, dataCount, 0, [&](int32 start, int32 end) // Start from 1. at index [0] was scene
             {
-                i++; // Start from 1. at index [0] was scene
-                auto& stream = data[i];
-                auto obj = SceneObjectsFactory::Spawn(context, stream);
-                objects[i] = obj;
-                if (obj)
+                for (int32 i = start; i < end; i++)
                 {
-                    obj->RegisterObject();
+                    auto& stream = data[i];
+                    auto obj = SceneObjectsFactory::Spawn(context, stream);
+                    objects[i] = obj;
+                    if (obj)
+                    {
+                        obj->RegisterObject();
 #if USE_EDITOR
-                    // Auto-create C# objects for all actors in Editor during scene load when running in async (so main thread already has all of them)
-                    obj->CreateManaged();
+                        // Auto-create C# objects for all actors in Editor during scene load when running in async (so main thread already has all of them)
+                        obj->CreateManaged();
 #endif
+                    }
+                    else
+                        SceneObjectsFactory::HandleObjectDeserializationError(stream);
                 }
-                else
-                    SceneObjectsFactory::HandleObjectDeserializationError(stream);
-            }, dataCount - 1);
+            });
             ScenesLock.Lock();
         }
         else
@@ -992,26 +1006,44 @@ bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** ou
     {
         PROFILE_CPU_NAMED("Deserialize");
         SceneObject** objects = sceneObjects->Get();
-        bool wasAsync = context.Async;
-        context.Async = false; // TODO: before doing full async for scene objects fix:
-        // TODO: - fix Actor's Scripts and Children order when loading objects data out of order via async jobs
-        // TODO: - add _loadNoAsync flag to SceneObject or Actor to handle non-async loading for those types (eg. UIControl/UICanvas)
         if (context.Async)
         {
+            // Cache the objects parents to restore the hierarchy order after loading (see restoreLoadOrder)
+            Array<Actor*> prevParents;
+            prevParents.Resize(dataCount);
+            for (int32 i = 0; i < dataCount; i++)
+                prevParents.Get()[i] = objects[i] ? objects[i]->GetParent() : nullptr;
+
             ScenesLock.Unlock(); // Unlock scenes from Main Thread so Job Threads can use it to safely setup actors hierarchy (see Actor::Deserialize)
-            JobSystem::Execute([&](int32 i)
+            JobSystem::ParallelFor(1, dataCount, 0, [&](int32 start, int32 end) // Start from 1. at index [0] was scene
+            {
+                auto& idMapping = Scripting::ObjectsLookupIdMapping.Get();
+                for (int32 i = start; i < end; i++)
+                {
+                    auto obj = objects[i];
+                    if (obj && !EnumHasAnyFlags(obj->Flags, ObjectFlags::NoAsyncDeserialize))
+                    {
+                        idMapping = &context.GetModifier()->IdsMapping;
+                        SceneObjectsFactory::Deserialize(context, obj, data[i]);
+                    }
+                }
+                idMapping = nullptr;
+            });
+            ScenesLock.Lock();
+
+            // Load objects that cannot be loaded on Job Threads
+            for (int32 i = 1; i < dataCount; i++)
             {
-                i++; // Start from 1. at index [0] was scene
                 auto obj = objects[i];
-                if (obj)
+                if (obj && EnumHasAnyFlags(obj->Flags, ObjectFlags::NoAsyncDeserialize))
                 {
-                    auto& idMapping = Scripting::ObjectsLookupIdMapping.Get();
-                    idMapping = &context.GetModifier()->IdsMapping;
+                    Scripting::ObjectsLookupIdMapping.Set(&context.GetModifier()->IdsMapping);
                     SceneObjectsFactory::Deserialize(context, obj, data[i]);
-                    idMapping = nullptr;
                 }
-            }, dataCount - 1);
-            ScenesLock.Lock();
+            }
+            Scripting::ObjectsLookupIdMapping.Set(nullptr);
+
+            restoreLoadOrder(objects, prevParents.Get(), dataCount);
         }
         else
         {
@@ -1025,7 +1057,6 @@ bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** ou
             }
             Scripting::ObjectsLookupIdMapping.Set(nullptr);
         }
-        context.Async = wasAsync;
     }
 
     // /\ all above this has to be done on multiple threads at once
@@ -1089,6 +1120,48 @@ bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** ou
     return false;
 }
 
+void LevelImpl::restoreLoadOrder(SceneObject** objects, Actor* const* prevParents, int32 count)
+{
+    PROFILE_CPU();
+
+    // Objects linked to the parent during loading were appended at the end of its children (or scripts) list in the order of the jobs execution
+    Dictionary<Actor*, int32> linkedChildren, linkedScripts;
+    for (int32 i = 1; i < count; i++)
+    {
+        SceneObject* obj = objects[i];
+        Actor* parent = obj ? obj->GetParent() : nullptr;
+        if (parent && parent != prevParents[i])
+        {
+            auto& linked = obj->Is<Actor>() ? linkedChildren : linkedScripts;
+            int32* linkedCount = linked.TryGet(parent);
+            if (linkedCount)
+                (*linkedCount)++;
+            else
+                linked.Add(parent, 1);
+        }
+    }
+    if (linkedChildren.IsEmpty() && linkedScripts.IsEmpty())
+        return;
+    for (auto& e : linkedChildren)
+        e.Value = e.Key->Children.Count() - e.Value;
+    for (auto& e : linkedScripts)
+        e.Value = e.Key->Scripts.Count() - e.Value;
+
+    // Write those objects back in the order of the scene data (the same as when loading on a single thread)
+    for (int32 i = 1; i < count; i++)
+    {
+        SceneObject* obj = objects[i];
+        Actor* parent = obj ? obj->GetParent() : nullptr;
+        if (parent && parent != prevParents[i])
+        {
+            if (obj->Is<Actor>())
+                parent->Children[linkedChildren[parent]++] = (Actor*)obj;
+            else
+                parent->Scripts[linkedScripts[parent]++] = (Script*)obj;
+        }
+    }
+}
+
 bool LevelImpl::saveScene(Scene* scene)
 {
 #if USE_EDITOR
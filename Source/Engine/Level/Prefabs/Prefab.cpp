@@ -7,16 +7,15 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Level/Prefabs/PrefabManager.h"
 #include "Engine/Level/Actor.h"
-#include "Engine/Threading/Threading.h"
-#if USE_EDITOR
 #include "Engine/Scripting/Scripting.h"
-#endif
+#include "Engine/Threading/Threading.h"
 
 REGISTER_JSON_ASSET(Prefab, "FlaxEngine.Prefab", true);
 
 Prefab::Prefab(const SpawnParams& params, const AssetInfo* info)
     : JsonAssetBase(params, info)
     , _isCreatingDefaultInstance(false)
+    , _hasSpawnTemplate(false)
     , _defaultInstance(nullptr)
     , ObjectsCount(0)
 {
@@ -52,6 +51,38 @@ Guid Prefab::GetRootObjectId() const
     return ObjectsIds[objectIndex];
 }
 
+const Prefab::SpawnTemplate& Prefab::GetSpawnTemplate()
+{
+    ASSERT(IsLoaded());
+    ScopeLock lock(Locker);
+    if (_hasSpawnTemplate)
+        return _spawnTemplate;
+    _hasSpawnTemplate = true;
+
+    // Find the root object once
+    const Guid rootObjectId = GetRootObjectId();
+    _spawnTemplate.RootIndex = ObjectsIds.Find(rootObjectId);
+
+    // Resolve the objects types to skip searching them by name on every spawn
+    const auto& data = *Data;
+    _spawnTemplate.Types.Resize(ObjectsCount);
+    for (int32 i = 0; i < ObjectsCount; i++)
+    {
+        auto& objData = data[i];
+        ScriptingTypeHandle type;
+        const auto typeNameMember = objData.FindMember("TypeName");
+        if (typeNameMember != objData.MemberEnd() && typeNameMember->value.IsString() && !JsonTools::GetGuid(objData, "PrefabObjectID").IsValid())
+        {
+            type = Scripting::FindScriptingType(typeNameMember->value.GetStringAnsiView());
+            if (type && !SceneObject::TypeInitializer.IsAssignableFrom(type))
+                type = ScriptingTypeHandle();
+        }
+        _spawnTemplate.Types[i] = type;
+    }
+
+    return _spawnTemplate;
+}
+
 Actor* Prefab::GetDefaultInstance()
 {
     ScopeLock lock(Locker);
@@ -107,6 +138,14 @@ void Prefab::DeleteDefaultInstance()
     }
 }
 
+void Prefab::DeleteSpawnTemplate()
+{
+    ScopeLock lock(Locker);
+    _hasSpawnTemplate = false;
+    _spawnTemplate.RootIndex = -1;
+    _spawnTemplate.Types.Resize(0);
+}
+
 Asset::LoadResult Prefab::loadAsset()
 {
     // Base
@@ -167,6 +206,7 @@ Asset::LoadResult Prefab::loadAsset()
     // Register for scripts reload and unload (need to cleanup all user objects including scripts that may be attached to the default instance - it can be always restored)
     Scripting::ScriptsReloading.Bind<Prefab, &Prefab::DeleteDefaultInstance>(this);
     Scripting::ScriptsUnload.Bind<Prefab, &Prefab::DeleteDefaultInstance>(this);
+    Scripting::ScriptsReloading.Bind<Prefab, &Prefab::DeleteSpawnTemplate>(this);
 #endif
 
     return LoadResult::Ok;
@@ -178,6 +218,7 @@ void Prefab::unload(bool isReloading)
     // Unlink
     Scripting::ScriptsReloading.Unbind<Prefab, &Prefab::DeleteDefaultInstance>(this);
     Scripting::ScriptsUnload.Unbind<Prefab, &Prefab::DeleteDefaultInstance>(this);
+    Scripting::ScriptsReloading.Unbind<Prefab, &Prefab::DeleteSpawnTemplate>(this);
 #endif
 
     // Base
@@ -190,6 +231,7 @@ void Prefab::unload(bool isReloading)
     ObjectsDataCache.SetCapacity(0);
     ObjectsCache.Clear();
     ObjectsCache.SetCapacity(0);
+    DeleteSpawnTemplate();
     if (_defaultInstance)
     {
         _defaultInstance->DeleteObject();
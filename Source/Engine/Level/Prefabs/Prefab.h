@@ -5,6 +5,7 @@
 #include "Engine/Content/JsonAsset.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Scripting/ScriptingType.h"
 
 class Actor;
 class SceneObject;
@@ -16,9 +17,28 @@ class SceneObject;
 API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
 {
     DECLARE_ASSET_HEADER(Prefab);
+public:
+    /// <summary>
+    /// The prefab data resolved once and reused by all spawned prefab instances.
+    /// </summary>
+    struct SpawnTemplate
+    {
+        /// <summary>
+        /// The index of the root object in the prefab objects data. -1 if not found.
+        /// </summary>
+        int32 RootIndex = -1;
+
+        /// <summary>
+        /// The types of the objects (the same order as the prefab objects data). Empty for objects that need to be created from the data (eg. nested prefab instances).
+        /// </summary>
+        Array<ScriptingTypeHandle> Types;
+    };
+
 private:
     bool _isCreatingDefaultInstance;
+    bool _hasSpawnTemplate;
     Actor* _defaultInstance;
+    SpawnTemplate _spawnTemplate;
 
 public:
     /// <summary>
@@ -52,6 +72,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
     /// </summary>
     Guid GetRootObjectId() const;
 
+    /// <summary>
+    /// Gets the spawn template used to create the prefab instances. Prepared on the first use. Asset must be loaded.
+    /// </summary>
+    const SpawnTemplate& GetSpawnTemplate();
+
     /// <summary>
     /// Requests the default prefab object instance. Deserializes the prefab objects from the asset. Skips if already done.
     /// </summary>
@@ -86,6 +111,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
     void SyncNestedPrefabs(const NestedPrefabsList& allPrefabs, Array<PrefabInstancesData>& allPrefabsInstancesData) const;
 #endif
     void DeleteDefaultInstance();
+    void DeleteSpawnTemplate();
 
 protected:
     // [JsonAssetBase]
@@ -19,12 +19,42 @@
 #include "Engine/Scripting/Script.h"
 #include "Engine/Scripting/Scripting.h"
 
+int32 PrefabManager::PoolCapacity = 256;
 #if USE_EDITOR
 bool PrefabManager::IsCreatingPrefab = false;
 Dictionary<Guid, Array<Actor*>> PrefabManager::PrefabsReferences;
 CriticalSection PrefabManager::PrefabsReferencesLocker;
 #endif
 
+namespace
+{
+    // Parked prefab instances (ids of the inactive root actors) per prefab asset
+    CriticalSection PoolsLocker;
+    Dictionary<Guid, Array<Guid>> Pools;
+
+    void ResetPooledInstance(const Prefab* prefab, Actor* actor)
+    {
+        // Restore the local transformation and the active state of the prefab objects (skip the root which is placed by the caller)
+        for (Actor* child : actor->Children)
+        {
+            SceneObject* defaultObject;
+            if (child->GetPrefabID() == prefab->GetID() && prefab->ObjectsCache.TryGet(child->GetPrefabObjectID(), defaultObject))
+            {
+                const Actor* defaultActor = (const Actor*)defaultObject;
+                child->SetLocalTransform(defaultActor->GetLocalTransform());
+                child->SetIsActive(defaultActor->GetIsActive());
+            }
+            ResetPooledInstance(prefab, child);
+        }
+        for (Script* script : actor->Scripts)
+        {
+            SceneObject* defaultObject;
+            if (script->GetPrefabID() == prefab->GetID() && prefab->ObjectsCache.TryGet(script->GetPrefabObjectID(), defaultObject))
+                script->SetEnabled(((const Script*)defaultObject)->GetEnabled());
+        }
+    }
+}
+
 class PrefabManagerService : public EngineService
 {
 public:
@@ -32,10 +62,33 @@ class PrefabManagerService : public EngineService
         : EngineService(TEXT("Prefab Manager"))
     {
     }
+
+    void Dispose() override
+    {
+        ScopeLock lock(PoolsLocker);
+        Pools.Clear();
+        Pools.SetCapacity(0);
+    }
 };
 
 PrefabManagerService PrefabManagerServiceInstance;
 
+struct PrefabManager::SpawnContext
+{
+    Prefab* Asset;
+    const Prefab::SpawnTemplate* Template;
+    CollectionPoolCache<ActorsCache::SceneObjectsListType>::ScopeCache SceneObjects;
+    CollectionPoolCache<ISerializeModifier, Cache::ISerializeModifierClearCallback>::ScopeCache Modifier;
+
+    SpawnContext(Prefab* prefab)
+        : Asset(prefab)
+        , Template(&prefab->GetSpawnTemplate())
+        , SceneObjects(ActorsCache::SceneObjectsListCache.Get())
+        , Modifier(Cache::ISerializeModifier.Get())
+    {
+    }
+};
+
 Actor* PrefabManager::SpawnPrefab(Prefab* prefab)
 {
     Actor* parent = Level::Scenes.Count() != 0 ? Level::Scenes.Get()[0] : nullptr;
@@ -100,16 +153,28 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
         LOG(Warning, "Prefab has no objects. {0}", prefab->ToString());
         return nullptr;
     }
+    SpawnContext spawnContext(prefab);
+    return SpawnPrefabInstance(spawnContext, transform, parent, objectsCache, withSynchronization);
+}
+
+Actor* PrefabManager::SpawnPrefabInstance(SpawnContext& spawnContext, const Transform& transform, Actor* parent, Dictionary<Guid, SceneObject*>* objectsCache, bool withSynchronization)
+{
+    Prefab* prefab = spawnContext.Asset;
+    const Prefab::SpawnTemplate& spawnTemplate = *spawnContext.Template;
     const Guid prefabId = prefab->GetID();
+    const int32 dataCount = prefab->ObjectsCount;
 
     // Note: we need to generate unique Ids for the deserialized objects (actors and scripts) to prevent Ids collisions
     // Prefab asset during loading caches the object Ids stored inside the file
 
     // Prepare
-    CollectionPoolCache<ActorsCache::SceneObjectsListType>::ScopeCache sceneObjects = ActorsCache::SceneObjectsListCache.Get();
+    auto& sceneObjects = spawnContext.SceneObjects;
+    sceneObjects->Clear();
     sceneObjects->Resize(dataCount);
-    CollectionPoolCache<ISerializeModifier, Cache::ISerializeModifierClearCallback>::ScopeCache modifier = Cache::ISerializeModifier.Get();
+    auto& modifier = spawnContext.Modifier;
     modifier->EngineBuild = prefab->DataEngineBuild;
+    modifier->CurrentInstance = -1;
+    modifier->IdsMapping.Clear();
     modifier->IdsMapping.EnsureCapacity(prefab->ObjectsIds.Count() * 4);
     for (int32 i = 0; i < prefab->ObjectsIds.Count(); i++)
     {
@@ -129,10 +194,23 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
     for (int32 i = 0; i < dataCount; i++)
     {
         auto& stream = data[i];
-        SceneObject* obj = SceneObjectsFactory::Spawn(context, stream);
+        SceneObject* obj;
+        const ScriptingTypeHandle& type = spawnTemplate.Types.Get()[i];
+        if (type)
+        {
+            // Create object of the type resolved by the prefab spawn template
+            const ScriptingObjectSpawnParams params(modifier->IdsMapping.At(prefab->ObjectsIds.Get()[i]), type);
+            obj = (SceneObject*)type.GetType().Script.Spawn(params);
+        }
+        else
+        {
+            obj = SceneObjectsFactory::Spawn(context, stream);
+        }
         sceneObjects->At(i) = obj;
         if (obj)
             obj->RegisterObject();
+        else if (type)
+            LOG(Warning, "Failed to spawn object of type {0}.", type.ToString(true));
         else
             SceneObjectsFactory::HandleObjectDeserializationError(stream);
     }
@@ -162,13 +240,7 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
     }
 
     // Pick prefab root object
-    Actor* root = nullptr;
-    const Guid prefabRootObjectId = prefab->GetRootObjectId();
-    for (int32 i = 0; i < dataCount && !root; i++)
-    {
-        if (JsonTools::GetGuid(data[i], "ID") == prefabRootObjectId)
-            root = dynamic_cast<Actor*>(sceneObjects->At(i));
-    }
+    Actor* root = spawnTemplate.RootIndex != -1 ? dynamic_cast<Actor*>(sceneObjects->At(spawnTemplate.RootIndex)) : nullptr;
     if (!root)
     {
         // Fallback to the first actor that has no parent
@@ -268,12 +340,11 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
     // Link objects to prefab (only deserialized from prefab data)
     for (int32 i = 0; i < dataCount; i++)
     {
-        auto& stream = data[i];
         SceneObject* obj = sceneObjects->At(i);
         if (!obj)
             continue;
 
-        const Guid prefabObjectId = JsonTools::GetGuid(stream, "ID");
+        const Guid& prefabObjectId = prefab->ObjectsIds.Get()[i];
         if (objectsCache)
             objectsCache->Add(prefabObjectId, obj);
         obj->LinkPrefab(prefabId, prefabObjectId);
@@ -297,6 +368,135 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
     return root;
 }
 
+Array<Actor*> PrefabManager::SpawnPrefabs(Prefab* prefab, const Array<Transform>& transforms, Actor* parent)
+{
+    PROFILE_CPU_NAMED("Prefab.SpawnBatch");
+    Array<Actor*> result;
+    if (prefab == nullptr)
+    {
+        Log::ArgumentNullException();
+        return result;
+    }
+    if (prefab->WaitForLoaded())
+    {
+        LOG(Warning, "Waiting for prefab asset be loaded failed. {0}", prefab->ToString());
+        return result;
+    }
+
+    if (prefab->ObjectsCount == 0)
+    {
+        LOG(Warning, "Prefab has no objects. {0}", prefab->ToString());
+        return result;
+    }
+
+    // Share the spawn template and the objects list and ids mapping containers between all instances
+    SpawnContext spawnContext(prefab);
+    result.Resize(transforms.Count());
+    for (int32 i = 0; i < transforms.Count(); i++)
+        result.Get()[i] = SpawnPrefabInstance(spawnContext, transforms.Get()[i], parent, nullptr, true);
+    return result;
+}
+
+Actor* PrefabManager::SpawnPooled(Prefab* prefab, const Transform& transform, Actor* parent)
+{
+    PROFILE_CPU_NAMED("Prefab.SpawnPooled");
+    if (prefab == nullptr)
+    {
+        Log::ArgumentNullException();
+        return nullptr;
+    }
+    if (!parent)
+        parent = Level::Scenes.Count() != 0 ? Level::Scenes.Get()[0] : nullptr;
+
+    // Pick the parked instance (skip the ones deleted in the meantime, eg. with their parent)
+    Actor* actor = nullptr;
+    {
+        ScopeLock lock(PoolsLocker);
+        Array<Guid>* pool = Pools.TryGet(prefab->GetID());
+        while (pool && pool->HasItems() && !actor)
+        {
+            actor = Scripting::TryFindObject<Actor>(pool->Pop());
+            if (actor && EnumHasAnyFlags(actor->Flags, ObjectFlags::WasMarkedToDelete))
+                actor = nullptr;
+        }
+    }
+    if (!actor)
+        return SpawnPrefab(prefab, transform, parent, nullptr);
+
+    // Reset the instance while it's still inactive (objects and scripts stay registered, scripts fields keep their values)
+    if (prefab->GetDefaultInstance())
+        ResetPooledInstance(prefab, actor);
+    if (actor->GetParent() != parent)
+        actor->SetParent(parent, false, false);
+    actor->SetTransform(transform);
+
+    // Reactivate the instance
+    actor->SetIsActive(true);
+    return actor;
+}
+
+void PrefabManager::Despawn(Actor* instance)
+{
+    if (instance == nullptr)
+    {
+        Log::ArgumentNullException();
+        return;
+    }
+    // Only the roots of the prefab instances can be reused (IsPrefabRoot is set only if the actor links to the root object of its prefab)
+    const Guid prefabId = instance->GetPrefabID();
+    if (prefabId.IsValid() && instance->IsPrefabRoot() && !EnumHasAnyFlags(instance->Flags, ObjectFlags::WasMarkedToDelete))
+    {
+        ScopeLock lock(PoolsLocker);
+        Array<Guid>& pool = Pools[prefabId];
+        const Guid id = instance->GetID();
+        if (pool.Contains(id))
+            return;
+        if (pool.Count() >= PoolCapacity)
+        {
+            // Remove the parked instances deleted in the meantime (eg. with their scene) before checking the capacity
+            for (int32 i = pool.Count() - 1; i >= 0; i--)
+            {
+                const Actor* actor = Scripting::TryFindObject<Actor>(pool[i]);
+                if (!actor || EnumHasAnyFlags(actor->Flags, ObjectFlags::WasMarkedToDelete))
+                    pool.RemoveAtKeepOrder(i);
+            }
+        }
+        if (pool.Count() < PoolCapacity)
+        {
+            // Park the instance
+            instance->SetIsActive(false);
+            pool.Add(id);
+            return;
+        }
+    }
+
+    // Not a prefab instance root or the pool is full
+    instance->DeleteObject();
+}
+
+void PrefabManager::ClearPool(Prefab* prefab)
+{
+    if (prefab == nullptr)
+    {
+        Log::ArgumentNullException();
+        return;
+    }
+    Array<Guid> pool;
+    {
+        ScopeLock lock(PoolsLocker);
+        Array<Guid>* prefabPool = Pools.TryGet(prefab->GetID());
+        if (!prefabPool)
+            return;
+        pool.Swap(*prefabPool);
+    }
+    for (const Guid& id : pool)
+    {
+        Actor* actor = Scripting::TryFindObject<Actor>(id);
+        if (actor)
+            actor->DeleteObject();
+    }
+}
+
 #if USE_EDITOR
 
 bool PrefabManager::CreatePrefab(Actor* targetActor, const StringView& outputPath, bool autoLink)
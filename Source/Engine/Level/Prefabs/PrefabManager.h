@@ -102,6 +102,46 @@ API_CLASS(Static) class FLAXENGINE_API PrefabManager
     /// <returns>The created actor (root) or null if failed.</returns>
     static Actor* SpawnPrefab(Prefab* prefab, const Transform& transform, Actor* parent, Dictionary<Guid, SceneObject*, HeapAllocation>* objectsCache, bool withSynchronization = true);
 
+    /// <summary>
+    /// Spawns multiple instances of the prefab objects (one per transform). Prefab spawn template and the objects list and ids mapping containers are prepared once and reused by all instances. If parent actor is specified then created actors are fully initialized (OnLoad event and BeginPlay is called if parent actor is already during gameplay).
+    /// </summary>
+    /// <param name="prefab">The prefab asset.</param>
+    /// <param name="transforms">The prefab instances transformations.</param>
+    /// <param name="parent">The parent actor to add spawned objects instances. Can be null to just deserialize contents of the prefab.</param>
+    /// <returns>The created actors (roots of the prefab instances, in the same order as transforms). Null for the failed instances.</returns>
+    API_FUNCTION() static Array<Actor*, HeapAllocation> SpawnPrefabs(Prefab* prefab, const Array<Transform, HeapAllocation>& transforms, Actor* parent);
+
+private:
+    struct SpawnContext;
+    static Actor* SpawnPrefabInstance(SpawnContext& spawnContext, const Transform& transform, Actor* parent, Dictionary<Guid, SceneObject*, HeapAllocation>* objectsCache, bool withSynchronization);
+
+public:
+    /// <summary>
+    /// The maximum amount of the parked instances per prefab. Instances despawned over the limit are deleted.
+    /// </summary>
+    API_FIELD() static int32 PoolCapacity;
+
+    /// <summary>
+    /// Spawns the instance of the prefab reusing the instance parked with Despawn if available (otherwise spawns a new one). Reused instance keeps its objects, scripts and registration. Its child actors local transformations and active states and scripts enabled states are restored to the prefab defaults, then it's linked to the parent and reactivated with the new transform. Scripts fields keep their values (state reset can be done by scripts in OnEnable).
+    /// </summary>
+    /// <param name="prefab">The prefab asset.</param>
+    /// <param name="transform">The prefab instance transform.</param>
+    /// <param name="parent">The parent actor to add spawned object instance. Null to use the first loaded scene.</param>
+    /// <returns>The prefab instance root actor or null if failed.</returns>
+    API_FUNCTION() static Actor* SpawnPooled(Prefab* prefab, const Transform& transform, Actor* parent = nullptr);
+
+    /// <summary>
+    /// Despawns the prefab instance by deactivating and parking it for reuse by SpawnPooled. Actors that are not prefab instance roots (or over the pool capacity) are deleted. Pooling saves the objects creation and deserialization but deactivation and reactivation still unregister and register the instance in the rendering and physics scenes.
+    /// </summary>
+    /// <param name="instance">The prefab instance root actor.</param>
+    API_FUNCTION() static void Despawn(Actor* instance);
+
+    /// <summary>
+    /// Deletes all instances of the prefab parked for reuse.
+    /// </summary>
+    /// <param name="prefab">The prefab asset.</param>
+    API_FUNCTION() static void ClearPool(Prefab* prefab);
+
 #if USE_EDITOR
 
     /// <summary>
@@ -2,6 +2,16 @@
 
 #define SCENE_RENDERING_USE_PROFILER_PER_ACTOR 0
 
+// Minimum amount of actors in the draw category to cull them via bounding volume hierarchy (smaller lists are culled linearly)
+#define SCENE_RENDERING_TREE_MIN_ACTORS 256
+
+// Amount of actors culled and drawn at once by a single draw job
+#define SCENE_RENDERING_DRAW_BATCH 32
+
+// Minimum amount of free entries (and minimum ratio to the entries count) in the draw category to compact it
+#define SCENE_RENDERING_COMPACT_MIN_FREE 64
+#define SCENE_RENDERING_COMPACT_MIN_FREE_RATIO 0.25f
+
 #include "SceneRendering.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderView.h"
@@ -27,23 +37,19 @@ void ISceneRenderingListener::ListenSceneRendering(SceneRendering* scene)
     }
 }
 
-FORCE_INLINE bool FrustumsListCull(const BoundingSphere& bounds, const Array<BoundingFrustum>& frustums)
-{
-    const int32 count = frustums.Count();
-    const BoundingFrustum* data = frustums.Get();
-    for (int32 i = 0; i < count; i++)
-    {
-        if (data[i].Intersects(bounds))
-            return true;
-    }
-    return false;
-}
-
 void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory category)
 {
     ScopeLock lock(Locker);
     if (category == PreRender)
     {
+        // Remove empty entries left after removed actors (before any drawing so no draw jobs use the lists)
+        for (int32 i = 0; i < MAX; i++)
+        {
+            const int32 freeCount = _freeKeys[i].Count();
+            if (freeCount >= SCENE_RENDERING_COMPACT_MIN_FREE && (float)freeCount >= (float)Actors[i].Count() * SCENE_RENDERING_COMPACT_MIN_FREE_RATIO)
+                Compact(i);
+        }
+
         // Register scene
         for (const auto& renderContext : renderContextBatch.Contexts)
             renderContext.List->Scenes.Add(this);
@@ -59,6 +65,8 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     auto& view = renderContextBatch.GetMainContext().View;
     auto& list = Actors[(int32)category];
     _drawListData = list.Get();
+    _drawCullingData = &_culling[(int32)category];
+    _drawListIndices = nullptr;
     _drawListSize = list.Count();
     _drawBatch = &renderContextBatch;
 
@@ -68,14 +76,25 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     for (int32 i = 0; i < frustumsCount; i++)
         _drawFrustumsData.Get()[i] = renderContextBatch.Contexts.Get()[i].View.CullingFrustum;
 
+    // Skip whole groups of actors outside the view for large scenes
+    if (_drawListSize >= SCENE_RENDERING_TREE_MIN_ACTORS)
+    {
+        PROFILE_CPU_NAMED("Culling");
+        _drawVisibleList.Clear();
+        _drawVisibleList.Add(_noCullingKeys[(int32)category]);
+        _trees[(int32)category].Query(_drawFrustumsData.Get(), frustumsCount, view.Origin, _drawVisibleList);
+        _drawListIndices = _drawVisibleList.Get();
+        _drawListSize = _drawVisibleList.Count();
+    }
+
     // Draw all visual components
-    _drawListIndex = -1;
+    _drawListIndex = 0;
     if (_drawListSize >= 64 && category == SceneDrawAsync && renderContextBatch.EnableAsync)
     {
         // Run in async via Job System
         Function<void(int32)> func;
         func.Bind<SceneRendering, &SceneRendering::DrawActorsJob>(this);
-        const uint64 waitLabel = JobSystem::Dispatch(func, JobSystem::GetThreadsCount());
+        const uint64 waitLabel = JobSystem::Dispatch(func, JobSystem::GetThreadsCount(), JobPriority::High);
         renderContextBatch.WaitLabels.Add(waitLabel);
     }
     else
@@ -132,6 +151,16 @@ void SceneRendering::Clear()
     _listeners.Clear();
     for (auto& e : Actors)
         e.Clear();
+    for (auto& e : _trees)
+        e.Clear();
+    for (auto& e : _noCullingKeys)
+        e.Clear();
+    for (auto& e : _culling)
+        e.Clear();
+    for (auto& e : _freeKeys)
+        e.Clear();
+    for (auto& e : _keys)
+        e.Clear();
 #if USE_EDITOR
     PhysicsDebug.Clear();
 #endif
@@ -141,23 +170,51 @@ void SceneRendering::AddActor(Actor* a, int32& key)
 {
     if (key != -1)
         return;
-    const int32 category = a->_drawCategory;
     ScopeLock lock(Locker);
+    AddActorEntry(a, &key);
+}
+
+void SceneRendering::AddActor(Actor* a)
+{
+    ScopeLock lock(Locker);
+    AddActorEntry(a, nullptr);
+}
+
+void SceneRendering::AddActorEntry(Actor* a, int32* keyPtr)
+{
+    const int32 category = a->_drawCategory;
     auto& list = Actors[category];
-    // TODO: track removedCount and skip searching for free entry if there is none
-    key = 0;
-    for (; key < list.Count(); key++)
+    auto& freeKeys = _freeKeys[category];
+    int32 key;
+    if (freeKeys.HasItems())
     {
-        if (list.Get()[key].Actor == nullptr)
-            break;
+        key = freeKeys.Pop();
     }
-    if (key == list.Count())
+    else
+    {
+        key = list.Count();
         list.AddOne();
+        _keys[category].AddOne();
+        _culling[category].Resize(list.Count());
+    }
+    _keys[category][key] = keyPtr;
+    if (keyPtr)
+        *keyPtr = key;
     auto& e = list[key];
     e.Actor = a;
     e.LayerMask = a->GetLayerMask();
     e.Bounds = a->GetSphere();
     e.NoCulling = a->_drawNoCulling;
+    _culling[category].Set(key, e.Bounds, e.LayerMask, e.NoCulling);
+    if (e.NoCulling)
+    {
+        e.TreeNode = -1;
+        _noCullingKeys[category].Add(key);
+    }
+    else
+    {
+        e.TreeNode = _trees[category].Add(e.Bounds, key);
+    }
     for (auto* listener : _listeners)
         listener->OnSceneRenderingAddActor(a);
 }
@@ -176,6 +233,9 @@ void SceneRendering::UpdateActor(Actor* a, int32& key)
             listener->OnSceneRenderingUpdateActor(a, e.Bounds);
         e.LayerMask = a->GetLayerMask();
         e.Bounds = a->GetSphere();
+        _culling[category].Set(key, e.Bounds, e.LayerMask, e.NoCulling);
+        if (e.TreeNode != -1)
+            _trees[category].Update(e.TreeNode, e.Bounds);
     }
 }
 
@@ -191,20 +251,60 @@ void SceneRendering::RemoveActor(Actor* a, int32& key)
         {
             for (auto* listener : _listeners)
                 listener->OnSceneRenderingRemoveActor(a);
+            if (e.TreeNode != -1)
+                _trees[category].Remove(e.TreeNode);
+            else
+                _noCullingKeys[category].Remove(key);
             e.Actor = nullptr;
             e.LayerMask = 0;
+            _culling[category].Reset(key);
+            _keys[category][key] = nullptr;
+            _freeKeys[category].Add(key);
         }
     }
     key = -1;
 }
 
-#define FOR_EACH_BATCH_ACTOR const int64 count = _drawListSize; while (true) { const int64 index = Platform::InterlockedIncrement(&_drawListIndex); if (index >= count) break; auto e = _drawListData[index];
-#define CHECK_ACTOR ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || FrustumsListCull(e.Bounds, _drawFrustumsData)))
-#define CHECK_ACTOR_SINGLE_FRUSTUM ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || view.CullingFrustum.Intersects(e.Bounds)))
+void SceneRendering::Compact(int32 category)
+{
+    PROFILE_CPU();
+    auto& list = Actors[category];
+    auto& keys = _keys[category];
+    auto& culling = _culling[category];
+    auto& noCullingKeys = _noCullingKeys[category];
+    noCullingKeys.Clear();
+
+    // Move actors into free entries (keeps the order to preserve memory locality)
+    int32 count = 0;
+    for (int32 key = 0; key < list.Count(); key++)
+    {
+        const DrawActor& e = list.Get()[key];
+        if (e.Actor == nullptr)
+            continue;
+        if (count != key)
+        {
+            list.Get()[count] = e;
+            keys.Get()[count] = keys.Get()[key];
+            if (keys.Get()[count])
+                *keys.Get()[count] = count;
+            culling.Copy(count, key);
+            if (e.TreeNode != -1)
+                _trees[category].SetKey(e.TreeNode, count);
+        }
+        if (e.TreeNode == -1)
+            noCullingKeys.Add(count);
+        count++;
+    }
+    list.Resize(count);
+    keys.Resize(count);
+    culling.Resize(count);
+    _freeKeys[category].Clear();
+}
+
 #if SCENE_RENDERING_USE_PROFILER_PER_ACTOR
-#define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(e.Actor); e.Actor->Draw(mode)
+#define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(actor); actor->Draw(mode)
 #else
-#define DRAW_ACTOR(mode) e.Actor->Draw(mode)
+#define DRAW_ACTOR(mode) actor->Draw(mode)
 #endif
 
 void SceneRendering::DrawActorsJob(int32)
@@ -212,50 +312,49 @@ void SceneRendering::DrawActorsJob(int32)
     PROFILE_CPU();
     auto& mainContext = _drawBatch->GetMainContext();
     const auto& view = mainContext.View;
-    if (view.IsOfflinePass)
+    const BoundingFrustum* frustums = _drawFrustumsData.Get();
+    const int32 frustumsCount = _drawFrustumsData.Count();
+    const int64 count = _drawListSize;
+    int32 visible[SCENE_RENDERING_DRAW_BATCH];
+    while (true)
     {
-        // Offline pass with additional static flags culling
-        FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
-            if (CHECK_ACTOR && (e.Actor->GetStaticFlags() & view.StaticFlagsMask) != StaticFlags::None)
+        // Cull the next batch of actors at once and draw the visible ones
+        const int64 start = Platform::InterlockedAdd(&_drawListIndex, SCENE_RENDERING_DRAW_BATCH);
+        if (start >= count)
+            break;
+        const int32 batchSize = (int32)Math::Min<int64>(count - start, SCENE_RENDERING_DRAW_BATCH);
+        const int32 visibleCount = _drawCullingData->Cull((int32)start, batchSize, _drawListIndices, frustums, frustumsCount, view.Origin, view.RenderLayersMask.Mask, visible);
+        if (view.IsOfflinePass)
+        {
+            // Offline pass with additional static flags culling
+            for (int32 i = 0; i < visibleCount; i++)
             {
-                DRAW_ACTOR(*_drawBatch);
+                Actor* actor = _drawListData[visible[i]].Actor;
+                if ((actor->GetStaticFlags() & view.StaticFlagsMask) != StaticFlags::None)
+                {
+                    DRAW_ACTOR(*_drawBatch);
+                }
             }
         }
-    }
-    else if (view.Origin.IsZero() && _drawFrustumsData.Count() == 1)
-    {
-        // Fast path for no origin shifting with a single context
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR_SINGLE_FRUSTUM)
+        else if (view.Origin.IsZero() && frustumsCount == 1)
+        {
+            // Fast path for no origin shifting with a single context
+            for (int32 i = 0; i < visibleCount; i++)
             {
+                Actor* actor = _drawListData[visible[i]].Actor;
                 DRAW_ACTOR(mainContext);
             }
         }
-    }
-    else if (view.Origin.IsZero())
-    {
-        // Fast path for no origin shifting
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR)
-            {
-                DRAW_ACTOR(*_drawBatch);
-            }
-        }
-    }
-    else
-    {
-        // Generic case
-        FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
-            if (CHECK_ACTOR)
+        else
+        {
+            // Generic case
+            for (int32 i = 0; i < visibleCount; i++)
             {
+                Actor* actor = _drawListData[visible[i]].Actor;
                 DRAW_ACTOR(*_drawBatch);
             }
         }
     }
 }
 
-#undef FOR_EACH_BATCH_ACTOR
-#undef CHECK_ACTOR
 #undef DRAW_ACTOR
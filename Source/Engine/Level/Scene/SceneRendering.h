@@ -8,6 +8,8 @@
 #include "Engine/Core/Math/BoundingFrustum.h"
 #include "Engine/Level/Actor.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "SceneRenderingTree.h"
+#include "SceneRenderingCulling.h"
 
 class SceneRenderTask;
 class SceneRendering;
@@ -75,6 +77,7 @@ class FLAXENGINE_API SceneRendering
         uint32 LayerMask;
         int8 NoCulling : 1;
         BoundingSphere Bounds;
+        int32 TreeNode;
     };
 
     /// <summary>
@@ -104,6 +107,17 @@ class FLAXENGINE_API SceneRendering
     friend ISceneRenderingListener;
     Array<ISceneRenderingListener*, InlinedAllocation<8>> _listeners;
 
+    // Actors bounding volume hierarchy (per draw category) used to cull whole groups of actors at once, actors without culling are tracked separately
+    SceneRenderingTree _trees[MAX];
+    Array<int32> _noCullingKeys[MAX];
+
+    // Actors culling data (per draw category) stored as structure-of-arrays in the same order as Actors
+    SceneRenderingCulling _culling[MAX];
+
+    // Free entries in Actors (per draw category) and the actors key locations to update when draw lists get compacted
+    Array<int32> _freeKeys[MAX];
+    Array<int32*> _keys[MAX];
+
 public:
     /// <summary>
     /// Draws the scene. Performs the optimized actors culling and draw calls submission for the current render pass (defined by the render view).
@@ -124,7 +138,10 @@ class FLAXENGINE_API SceneRendering
     void Clear();
 
 public:
+    // Registers the actor for drawing. The key has to stay valid until actor removal as it's updated when draw lists get compacted.
     void AddActor(Actor* a, int32& key);
+    // Registers the actor for drawing without tracking its key (for temporary scenes that get cleared instead of removing actors).
+    void AddActor(Actor* a);
     void UpdateActor(Actor* a, int32& key);
     void RemoveActor(Actor* a, int32& key);
 
@@ -184,10 +201,15 @@ class FLAXENGINE_API SceneRendering
 
 private:
     Array<BoundingFrustum> _drawFrustumsData;
+    Array<int32> _drawVisibleList;
     DrawActor* _drawListData;
+    const SceneRenderingCulling* _drawCullingData;
+    const int32* _drawListIndices;
     int64 _drawListSize;
     volatile int64 _drawListIndex;
     RenderContextBatch* _drawBatch;
 
     void DrawActorsJob(int32);
+    void AddActorEntry(Actor* a, int32* key);
+    void Compact(int32 category);
 };
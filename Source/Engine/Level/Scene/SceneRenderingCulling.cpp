@@ -0,0 +1,165 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "SceneRenderingCulling.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Core/SIMD.h"
+
+// Amount of objects gathered into vector registers at once (frustum planes are loaded once per block)
+#define SCENE_RENDERING_CULLING_BLOCK 64
+
+void SceneRenderingCulling::Resize(int32 count)
+{
+    const int32 prevCount = Count();
+    CenterX.Resize(count);
+    CenterY.Resize(count);
+    CenterZ.Resize(count);
+    Radius.Resize(count);
+    LayerMask.Resize(count);
+    for (int32 i = prevCount; i < count; i++)
+    {
+        CenterX.Get()[i] = 0;
+        CenterY.Get()[i] = 0;
+        CenterZ.Get()[i] = 0;
+        Radius.Get()[i] = 0;
+        LayerMask.Get()[i] = 0;
+    }
+}
+
+void SceneRenderingCulling::Set(int32 index, const BoundingSphere& bounds, uint32 layerMask, bool noCulling)
+{
+    CenterX.Get()[index] = bounds.Center.X;
+    CenterY.Get()[index] = bounds.Center.Y;
+    CenterZ.Get()[index] = bounds.Center.Z;
+    Radius.Get()[index] = noCulling ? MAX_float : (float)bounds.Radius;
+    LayerMask.Get()[index] = layerMask;
+}
+
+void SceneRenderingCulling::Copy(int32 dstIndex, int32 srcIndex)
+{
+    CenterX.Get()[dstIndex] = CenterX.Get()[srcIndex];
+    CenterY.Get()[dstIndex] = CenterY.Get()[srcIndex];
+    CenterZ.Get()[dstIndex] = CenterZ.Get()[srcIndex];
+    Radius.Get()[dstIndex] = Radius.Get()[srcIndex];
+    LayerMask.Get()[dstIndex] = LayerMask.Get()[srcIndex];
+}
+
+void SceneRenderingCulling::Clear()
+{
+    CenterX.Clear();
+    CenterY.Clear();
+    CenterZ.Clear();
+    Radius.Clear();
+    LayerMask.Clear();
+}
+
+int32 SceneRenderingCulling::Cull(int32 start, int32 count, const int32* indices, const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, uint32 layerMask, int32* result) const
+{
+    int32 visibleCount = 0;
+    const Real* centerX = CenterX.Get();
+    const Real* centerY = CenterY.Get();
+    const Real* centerZ = CenterZ.Get();
+    const float* radius = Radius.Get();
+    const uint32* layerMasks = LayerMask.Get();
+#if USE_LARGE_WORLDS
+    // Double-precision positions are tested one by one to keep the culling precise far away from the world origin
+    for (int32 i = 0; i < count; i++)
+    {
+        const int32 index = indices ? indices[start + i] : start + i;
+        if ((layerMasks[index] & layerMask) == 0)
+            continue;
+        const BoundingSphere bounds(Vector3(centerX[index], centerY[index], centerZ[index]) - origin, radius[index]);
+        for (int32 frustumIndex = 0; frustumIndex < frustumsCount; frustumIndex++)
+        {
+            if (frustums[frustumIndex].Intersects(bounds))
+            {
+                result[visibleCount++] = index;
+                break;
+            }
+        }
+    }
+#else
+    // Move the frustum planes into the world space to skip shifting every object by the origin
+    Array<Float4, InlinedAllocation<6 * 8>> planes;
+    planes.Resize(frustumsCount * 6);
+    for (int32 frustumIndex = 0; frustumIndex < frustumsCount; frustumIndex++)
+    {
+        for (int32 planeIndex = 0; planeIndex < 6; planeIndex++)
+        {
+            const Plane plane = frustums[frustumIndex].GetPlane(planeIndex);
+            planes[frustumIndex * 6 + planeIndex] = Float4((float)plane.Normal.X, (float)plane.Normal.Y, (float)plane.Normal.Z, (float)(plane.D - Vector3::Dot(plane.Normal, origin)));
+        }
+    }
+
+    int32 keys[SCENE_RENDERING_CULLING_BLOCK];
+    SimdVector4 x[SCENE_RENDERING_CULLING_BLOCK / 4], y[SCENE_RENDERING_CULLING_BLOCK / 4], z[SCENE_RENDERING_CULLING_BLOCK / 4], r[SCENE_RENDERING_CULLING_BLOCK / 4], visible[SCENE_RENDERING_CULLING_BLOCK / 4];
+    for (int32 blockStart = 0; blockStart < count; blockStart += SCENE_RENDERING_CULLING_BLOCK)
+    {
+        const int32 blockSize = Math::Min(count - blockStart, SCENE_RENDERING_CULLING_BLOCK);
+        const int32 vectorsCount = (blockSize + 3) / 4;
+
+        // Gather objects into vector registers (padding lanes reuse the first object and are ignored)
+        for (int32 i = 0; i < vectorsCount * 4; i++)
+            keys[i] = i < blockSize ? (indices ? indices[start + blockStart + i] : start + blockStart + i) : keys[0];
+        const bool contiguous = indices == nullptr && ((start + blockStart) & 3) == 0;
+        for (int32 v = 0; v < vectorsCount; v++)
+        {
+            const int32* k = keys + v * 4;
+            if (contiguous && v * 4 + 4 <= blockSize)
+            {
+                x[v] = SIMD::Load(centerX + k[0]);
+                y[v] = SIMD::Load(centerY + k[0]);
+                z[v] = SIMD::Load(centerZ + k[0]);
+                r[v] = SIMD::Load(radius + k[0]);
+            }
+            else
+            {
+                x[v] = SIMD::Load(centerX[k[0]], centerX[k[1]], centerX[k[2]], centerX[k[3]]);
+                y[v] = SIMD::Load(centerY[k[0]], centerY[k[1]], centerY[k[2]], centerY[k[3]]);
+                z[v] = SIMD::Load(centerZ[k[0]], centerZ[k[1]], centerZ[k[2]], centerZ[k[3]]);
+                r[v] = SIMD::Load(radius[k[0]], radius[k[1]], radius[k[2]], radius[k[3]]);
+            }
+            visible[v] = SIMD::Splat(-1.0f);
+        }
+
+        // Sphere is inside the frustum if its signed distance to every plane is larger than -radius, so the minimum over the planes of (distance + radius) is non-negative
+        for (int32 frustumIndex = 0; frustumIndex < frustumsCount; frustumIndex++)
+        {
+            SimdVector4 nx[6], ny[6], nz[6], nd[6];
+            for (int32 planeIndex = 0; planeIndex < 6; planeIndex++)
+            {
+                const Float4& plane = planes.Get()[frustumIndex * 6 + planeIndex];
+                nx[planeIndex] = SIMD::Splat(plane.X);
+                ny[planeIndex] = SIMD::Splat(plane.Y);
+                nz[planeIndex] = SIMD::Splat(plane.Z);
+                nd[planeIndex] = SIMD::Splat(plane.W);
+            }
+            for (int32 v = 0; v < vectorsCount; v++)
+            {
+                const SimdVector4 vx = x[v], vy = y[v], vz = z[v], vr = r[v];
+                SimdVector4 minDistance = SIMD::Add(SIMD::Add(SIMD::Mul(vx, nx[0]), SIMD::Mul(vy, ny[0])), SIMD::Add(SIMD::Mul(vz, nz[0]), SIMD::Add(nd[0], vr)));
+                for (int32 planeIndex = 1; planeIndex < 6; planeIndex++)
+                {
+                    const SimdVector4 distance = SIMD::Add(SIMD::Add(SIMD::Mul(vx, nx[planeIndex]), SIMD::Mul(vy, ny[planeIndex])), SIMD::Add(SIMD::Mul(vz, nz[planeIndex]), SIMD::Add(nd[planeIndex], vr)));
+                    minDistance = SIMD::Min(minDistance, distance);
+                }
+                visible[v] = SIMD::Max(visible[v], minDistance);
+            }
+        }
+
+        // Write visible objects that pass the layer mask test
+        for (int32 v = 0; v < vectorsCount; v++)
+        {
+            const int32 mask = ~SIMD::MoveMask(visible[v]) & 0xf;
+            if (mask == 0)
+                continue;
+            for (int32 lane = 0; lane < 4; lane++)
+            {
+                const int32 i = v * 4 + lane;
+                if (mask & (1 << lane) && i < blockSize && (layerMasks[keys[i]] & layerMask) != 0)
+                    result[visibleCount++] = keys[i];
+            }
+        }
+    }
+#endif
+    return visibleCount;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+
+/// <summary>
+/// Culling data of the scene objects stored as structure-of-arrays (indexed by the object key) to test multiple objects at once against the view frustums with SIMD.
+/// </summary>
+class FLAXENGINE_API SceneRenderingCulling
+{
+public:
+    /// <summary>
+    /// The bounding sphere center X components (in world space).
+    /// </summary>
+    Array<Real> CenterX;
+
+    /// <summary>
+    /// The bounding sphere center Y components (in world space).
+    /// </summary>
+    Array<Real> CenterY;
+
+    /// <summary>
+    /// The bounding sphere center Z components (in world space).
+    /// </summary>
+    Array<Real> CenterZ;
+
+    /// <summary>
+    /// The bounding sphere radius. Objects without culling use the maximum value so they always pass the frustum test.
+    /// </summary>
+    Array<float> Radius;
+
+    /// <summary>
+    /// The objects layer mask. Unused entries have zero mask so they never pass the layer test.
+    /// </summary>
+    Array<uint32> LayerMask;
+
+public:
+    /// <summary>
+    /// Gets the amount of entries.
+    /// </summary>
+    FORCE_INLINE int32 Count() const
+    {
+        return Radius.Count();
+    }
+
+    /// <summary>
+    /// Changes the amount of entries. New entries are unused.
+    /// </summary>
+    /// <param name="count">The entries count.</param>
+    void Resize(int32 count);
+
+    /// <summary>
+    /// Sets the object data.
+    /// </summary>
+    /// <param name="index">The object index.</param>
+    /// <param name="bounds">The object bounds (in world space).</param>
+    /// <param name="layerMask">The object layer mask.</param>
+    /// <param name="noCulling">True if object should skip the frustum culling.</param>
+    void Set(int32 index, const BoundingSphere& bounds, uint32 layerMask, bool noCulling);
+
+    /// <summary>
+    /// Copies the object data to the other entry.
+    /// </summary>
+    /// <param name="dstIndex">The destination object index.</param>
+    /// <param name="srcIndex">The source object index.</param>
+    void Copy(int32 dstIndex, int32 srcIndex);
+
+    /// <summary>
+    /// Marks the entry as unused.
+    /// </summary>
+    /// <param name="index">The object index.</param>
+    FORCE_INLINE void Reset(int32 index)
+    {
+        LayerMask.Get()[index] = 0;
+    }
+
+    /// <summary>
+    /// Removes all entries.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Tests the range of objects against the frustums and layer mask (4 objects at once). Outputs a compact list of visible objects.
+    /// </summary>
+    /// <param name="start">The first object to test (or the first item in indices list).</param>
+    /// <param name="count">The amount of objects to test.</param>
+    /// <param name="indices">The optional list with indices of the objects to test. If null, then objects are tested in a contiguous range.</param>
+    /// <param name="frustums">The frustums to test (in origin-relative space). Object is visible if it intersects with any of them.</param>
+    /// <param name="frustumsCount">The frustums count.</param>
+    /// <param name="origin">The world origin to subtract from the objects bounds (used by large worlds).</param>
+    /// <param name="layerMask">The view layer mask.</param>
+    /// <param name="result">The output buffer for indices of visible objects. Must be able to hold count elements.</param>
+    /// <returns>The amount of visible objects written to the result.</returns>
+    int32 Cull(int32 start, int32 count, const int32* indices, const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, uint32 layerMask, int32* result) const;
+};
@@ -0,0 +1,294 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "SceneRenderingTree.h"
+
+// Leaf nodes bounds enlargement (constant and relative to the object size) to reduce tree updates for moving objects
+#define SCENE_RENDERING_TREE_MARGIN 10.0f
+#define SCENE_RENDERING_TREE_MARGIN_SCALE 0.1f
+
+namespace
+{
+    FORCE_INLINE Real GetArea(const BoundingBox& box)
+    {
+        const Vector3 size = box.Maximum - box.Minimum;
+        return 2 * (size.X * size.Y + size.Y * size.Z + size.Z * size.X);
+    }
+
+    FORCE_INLINE BoundingBox GetLeafBounds(const BoundingSphere& bounds)
+    {
+        const Real margin = bounds.Radius * (1.0f + SCENE_RENDERING_TREE_MARGIN_SCALE) + SCENE_RENDERING_TREE_MARGIN;
+        return BoundingBox(bounds.Center - margin, bounds.Center + margin);
+    }
+}
+
+int32 SceneRenderingTree::Add(const BoundingSphere& bounds, int32 key)
+{
+    const int32 leaf = AllocateNode();
+    Node& node = _nodes[leaf];
+    node.Bounds = GetLeafBounds(bounds);
+    node.Key = key;
+    InsertLeaf(leaf);
+    return leaf;
+}
+
+bool SceneRenderingTree::Update(int32 leaf, const BoundingSphere& bounds)
+{
+    Node& node = _nodes[leaf];
+    const BoundingBox box = BoundingBox::FromSphere(bounds);
+    if (node.Bounds.Contains(box) == ContainmentType::Contains)
+        return false;
+    RemoveLeaf(leaf);
+    _nodes[leaf].Bounds = GetLeafBounds(bounds);
+    InsertLeaf(leaf);
+    return true;
+}
+
+void SceneRenderingTree::Remove(int32 leaf)
+{
+    RemoveLeaf(leaf);
+    FreeNode(leaf);
+}
+
+void SceneRenderingTree::Clear()
+{
+    _nodes.Clear();
+    _root = -1;
+    _freeList = -1;
+}
+
+void SceneRenderingTree::Query(const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, Array<int32>& result) const
+{
+    if (_root == -1)
+        return;
+    const Node* nodes = _nodes.Get();
+    Array<int32, InlinedAllocation<64>> stack;
+    stack.Add(_root);
+    while (stack.HasItems())
+    {
+        const int32 index = stack.Pop();
+        const Node& node = nodes[index];
+        const BoundingBox box(node.Bounds.Minimum - origin, node.Bounds.Maximum - origin);
+        ContainmentType containment = ContainmentType::Disjoint;
+        for (int32 i = 0; i < frustumsCount; i++)
+        {
+            const ContainmentType type = frustums[i].Contains(box);
+            if (type == ContainmentType::Contains)
+            {
+                containment = ContainmentType::Contains;
+                break;
+            }
+            if (type == ContainmentType::Intersects)
+                containment = ContainmentType::Intersects;
+        }
+        if (containment == ContainmentType::Disjoint)
+            continue;
+        if (node.IsLeaf())
+            result.Add(node.Key);
+        else if (containment == ContainmentType::Contains)
+            CollectLeaves(index, result);
+        else
+        {
+            stack.Add(node.Children[0]);
+            stack.Add(node.Children[1]);
+        }
+    }
+}
+
+int32 SceneRenderingTree::AllocateNode()
+{
+    int32 index;
+    if (_freeList != -1)
+    {
+        index = _freeList;
+        _freeList = _nodes[index].Parent;
+    }
+    else
+    {
+        index = _nodes.Count();
+        _nodes.AddOne();
+    }
+    Node& node = _nodes[index];
+    node.Parent = -1;
+    node.Children[0] = -1;
+    node.Children[1] = -1;
+    node.Height = 0;
+    node.Key = -1;
+    return index;
+}
+
+void SceneRenderingTree::FreeNode(int32 index)
+{
+    Node& node = _nodes[index];
+    node.Parent = _freeList;
+    node.Height = -1;
+    _freeList = index;
+}
+
+void SceneRenderingTree::InsertLeaf(int32 leaf)
+{
+    if (_root == -1)
+    {
+        _root = leaf;
+        _nodes[leaf].Parent = -1;
+        return;
+    }
+
+    // Find the best sibling for the new leaf (using surface area heuristic)
+    const BoundingBox leafBounds = _nodes[leaf].Bounds;
+    int32 index = _root;
+    while (!_nodes[index].IsLeaf())
+    {
+        const Node& node = _nodes[index];
+        BoundingBox combined;
+        BoundingBox::Merge(node.Bounds, leafBounds, combined);
+        const Real combinedArea = GetArea(combined);
+
+        // Cost of creating a new parent for this node and the new leaf
+        const Real cost = 2 * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        const Real inheritanceCost = 2 * (combinedArea - GetArea(node.Bounds));
+
+        // Cost of descending into the children
+        Real childCosts[2];
+        for (int32 i = 0; i < 2; i++)
+        {
+            const Node& child = _nodes[node.Children[i]];
+            BoundingBox::Merge(child.Bounds, leafBounds, combined);
+            childCosts[i] = GetArea(combined) + inheritanceCost;
+            if (!child.IsLeaf())
+                childCosts[i] -= GetArea(child.Bounds);
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1])
+            break;
+        index = childCosts[0] < childCosts[1] ? node.Children[0] : node.Children[1];
+    }
+    const int32 sibling = index;
+
+    // Create a new parent for the sibling and the leaf
+    const int32 oldParent = _nodes[sibling].Parent;
+    const int32 newParent = AllocateNode();
+    Node& parent = _nodes[newParent];
+    parent.Parent = oldParent;
+    parent.Children[0] = sibling;
+    parent.Children[1] = leaf;
+    parent.Height = _nodes[sibling].Height + 1;
+    BoundingBox::Merge(leafBounds, _nodes[sibling].Bounds, parent.Bounds);
+    if (oldParent != -1)
+    {
+        Node& oldParentNode = _nodes[oldParent];
+        oldParentNode.Children[oldParentNode.Children[0] == sibling ? 0 : 1] = newParent;
+    }
+    else
+    {
+        _root = newParent;
+    }
+    _nodes[sibling].Parent = newParent;
+    _nodes[leaf].Parent = newParent;
+
+    // Walk back up the tree fixing the heights and bounds
+    Refit(newParent);
+}
+
+void SceneRenderingTree::RemoveLeaf(int32 leaf)
+{
+    if (leaf == _root)
+    {
+        _root = -1;
+        return;
+    }
+
+    // Replace the parent with the sibling
+    const int32 parent = _nodes[leaf].Parent;
+    const int32 grandParent = _nodes[parent].Parent;
+    const int32 sibling = _nodes[parent].Children[_nodes[parent].Children[0] == leaf ? 1 : 0];
+    _nodes[sibling].Parent = grandParent;
+    FreeNode(parent);
+    if (grandParent != -1)
+    {
+        Node& grandParentNode = _nodes[grandParent];
+        grandParentNode.Children[grandParentNode.Children[0] == parent ? 0 : 1] = sibling;
+        Refit(grandParent);
+    }
+    else
+    {
+        _root = sibling;
+    }
+}
+
+void SceneRenderingTree::Refit(int32 index)
+{
+    while (index != -1)
+    {
+        index = Balance(index);
+        Node& node = _nodes[index];
+        const Node& child0 = _nodes[node.Children[0]];
+        const Node& child1 = _nodes[node.Children[1]];
+        node.Height = 1 + Math::Max(child0.Height, child1.Height);
+        BoundingBox::Merge(child0.Bounds, child1.Bounds, node.Bounds);
+        index = node.Parent;
+    }
+}
+
+int32 SceneRenderingTree::Balance(int32 index)
+{
+    Node& a = _nodes[index];
+    if (a.IsLeaf() || a.Height < 2)
+        return index;
+
+    // Pick the taller child to rotate up if the subtree is imbalanced
+    const int32 balance = _nodes[a.Children[1]].Height - _nodes[a.Children[0]].Height;
+    if (balance >= -1 && balance <= 1)
+        return index;
+    const int32 slot = balance > 1 ? 1 : 0;
+    const int32 upIndex = a.Children[slot];
+    Node& up = _nodes[upIndex];
+    const int32 f = up.Children[0];
+    const int32 g = up.Children[1];
+
+    // Swap the node with its child
+    up.Children[0] = index;
+    up.Parent = a.Parent;
+    a.Parent = upIndex;
+    if (up.Parent != -1)
+    {
+        Node& parent = _nodes[up.Parent];
+        parent.Children[parent.Children[0] == index ? 0 : 1] = upIndex;
+    }
+    else
+    {
+        _root = upIndex;
+    }
+
+    // Keep the taller grandchild under the rotated node and move the other one to the old node
+    const bool fTaller = _nodes[f].Height > _nodes[g].Height;
+    up.Children[1] = fTaller ? f : g;
+    a.Children[slot] = fTaller ? g : f;
+    _nodes[a.Children[slot]].Parent = index;
+    a.Height = 1 + Math::Max(_nodes[a.Children[0]].Height, _nodes[a.Children[1]].Height);
+    BoundingBox::Merge(_nodes[a.Children[0]].Bounds, _nodes[a.Children[1]].Bounds, a.Bounds);
+    up.Height = 1 + Math::Max(a.Height, _nodes[up.Children[1]].Height);
+    BoundingBox::Merge(a.Bounds, _nodes[up.Children[1]].Bounds, up.Bounds);
+    return upIndex;
+}
+
+void SceneRenderingTree::CollectLeaves(int32 index, Array<int32>& result) const
+{
+    const Node* nodes = _nodes.Get();
+    Array<int32, InlinedAllocation<64>> stack;
+    stack.Add(index);
+    while (stack.HasItems())
+    {
+        const Node& node = nodes[stack.Pop()];
+        if (node.IsLeaf())
+        {
+            result.Add(node.Key);
+        }
+        else
+        {
+            stack.Add(node.Children[0]);
+            stack.Add(node.Children[1]);
+        }
+    }
+}
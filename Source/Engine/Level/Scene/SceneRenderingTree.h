@@ -0,0 +1,138 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+
+/// <summary>
+/// Dynamic bounding volume hierarchy (AABB tree) of the scene objects used to accelerate the culling. Maintained incrementally when objects are added, moved or removed and kept balanced via tree rotations.
+/// </summary>
+class FLAXENGINE_API SceneRenderingTree
+{
+public:
+    /// <summary>
+    /// The single tree node. Leaf nodes represent objects, other nodes always have two children.
+    /// </summary>
+    struct Node
+    {
+        /// <summary>
+        /// The node bounds (in world space). For leaf nodes it's enlarged object bounds so small movements don't need to update the tree.
+        /// </summary>
+        BoundingBox Bounds;
+
+        /// <summary>
+        /// The parent node index (-1 for root). For unused nodes it's the index of the next free node.
+        /// </summary>
+        int32 Parent;
+
+        /// <summary>
+        /// The child nodes indices (-1 for leaf nodes).
+        /// </summary>
+        int32 Children[2];
+
+        /// <summary>
+        /// The node height in the tree (0 for leaf nodes, -1 for unused nodes).
+        /// </summary>
+        int32 Height;
+
+        /// <summary>
+        /// The user key of the object represented by the leaf node.
+        /// </summary>
+        int32 Key;
+
+        FORCE_INLINE bool IsLeaf() const
+        {
+            return Children[0] == -1;
+        }
+    };
+
+private:
+    Array<Node> _nodes;
+    int32 _root = -1;
+    int32 _freeList = -1;
+
+public:
+    /// <summary>
+    /// Gets the tree nodes (including unused ones).
+    /// </summary>
+    FORCE_INLINE const Array<Node>& GetNodes() const
+    {
+        return _nodes;
+    }
+
+    /// <summary>
+    /// Gets the root node index (-1 if tree is empty).
+    /// </summary>
+    FORCE_INLINE int32 GetRoot() const
+    {
+        return _root;
+    }
+
+    /// <summary>
+    /// Gets the tree height (0 if tree is empty or has a single object).
+    /// </summary>
+    FORCE_INLINE int32 GetHeight() const
+    {
+        return _root != -1 ? _nodes[_root].Height : 0;
+    }
+
+public:
+    /// <summary>
+    /// Adds the object to the tree.
+    /// </summary>
+    /// <param name="bounds">The object bounds (in world space).</param>
+    /// <param name="key">The object key to return from the queries.</param>
+    /// <returns>The leaf node index that represents the object in the tree.</returns>
+    int32 Add(const BoundingSphere& bounds, int32 key);
+
+    /// <summary>
+    /// Updates the object bounds. Tree is modified only when object moves outside the enlarged bounds of the leaf node.
+    /// </summary>
+    /// <param name="leaf">The leaf node index.</param>
+    /// <param name="bounds">The object bounds (in world space).</param>
+    /// <returns>True if tree has been modified, otherwise false.</returns>
+    bool Update(int32 leaf, const BoundingSphere& bounds);
+
+    /// <summary>
+    /// Removes the object from the tree.
+    /// </summary>
+    /// <param name="leaf">The leaf node index.</param>
+    void Remove(int32 leaf);
+
+    /// <summary>
+    /// Changes the key of the object represented by the leaf node.
+    /// </summary>
+    /// <param name="leaf">The leaf node index.</param>
+    /// <param name="key">The object key.</param>
+    FORCE_INLINE void SetKey(int32 leaf, int32 key)
+    {
+        _nodes[leaf].Key = key;
+    }
+
+    /// <summary>
+    /// Removes all objects from the tree.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Finds all objects that are potentially visible from any of the given frustums. Skips the whole subtrees outside all frustums and accepts the whole subtrees fully inside any frustum without testing their children.
+    /// </summary>
+    /// <remarks>Uses enlarged object bounds so results contain objects that can be slightly outside the frustums.</remarks>
+    /// <param name="frustums">The frustums to test (in origin-relative space).</param>
+    /// <param name="frustumsCount">The frustums count.</param>
+    /// <param name="origin">The world origin to subtract from the objects bounds (used by large worlds).</param>
+    /// <param name="result">The output list to append the keys of the visible objects.</param>
+    void Query(const BoundingFrustum* frustums, int32 frustumsCount, const Vector3& origin, Array<int32>& result) const;
+
+private:
+    int32 AllocateNode();
+    void FreeNode(int32 index);
+    void InsertLeaf(int32 leaf);
+    void RemoveLeaf(int32 leaf);
+    void Refit(int32 index);
+    int32 Balance(int32 index);
+    void CollectLeaves(int32 index, Array<int32>& result) const;
+};
@@ -18,6 +18,7 @@
 #include "Engine/Physics/Colliders/MeshCollider.h"
 #include "Engine/Physics/Colliders/SplineCollider.h"
 #include "Engine/Threading/ThreadPoolTask.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Terrain/TerrainPatch.h"
 #include "Engine/Terrain/Terrain.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -750,6 +751,17 @@ class NavMeshTileBuildTask : public ThreadPoolTask
         if (NavBuildTasks.IsEmpty())
             NavBuildTasksMaxCount = 0;
     }
+
+protected:
+    // [ThreadPoolTask]
+    void Enqueue() override
+    {
+        // Tiles are built in the background jobs so they don't delay the frame jobs
+        JobSystem::Dispatch([this](int32)
+        {
+            Execute();
+        }, 1, JobPriority::Background);
+    }
 };
 
 void OnSceneUnloading(Scene* scene, const Guid& sceneId)
@@ -14,15 +14,42 @@
 #define MAX_NODES 2048
 #define USE_DATA_LINK 0
 #define USE_NAV_MESH_ALLOC 1
+#define NAV_MESH_WRITER_FLAG (1ll << 62)
 // TODO: try not using USE_NAV_MESH_ALLOC
 
 namespace
 {
-    FORCE_INLINE void InitFilter(dtQueryFilter& filter)
+    struct ReadScopeLock
     {
-        Platform::MemoryCopy(filter.m_areaCost, NavMeshRuntime::NavAreasCosts, sizeof(NavMeshRuntime::NavAreasCosts));
-        static_assert(sizeof(dtQueryFilter::m_areaCost) == sizeof(NavMeshRuntime::NavAreasCosts), "Invalid navmesh area cost list.");
-    }
+        const NavMeshRuntime* NavMesh;
+
+        FORCE_INLINE ReadScopeLock(const NavMeshRuntime* navMesh)
+            : NavMesh(navMesh)
+        {
+            NavMesh->ReadLock();
+        }
+
+        FORCE_INLINE ~ReadScopeLock()
+        {
+            NavMesh->ReadUnlock();
+        }
+    };
+
+    struct WriteScopeLock
+    {
+        NavMeshRuntime* NavMesh;
+
+        FORCE_INLINE WriteScopeLock(NavMeshRuntime* navMesh)
+            : NavMesh(navMesh)
+        {
+            NavMesh->WriteLock();
+        }
+
+        FORCE_INLINE ~WriteScopeLock()
+        {
+            NavMesh->WriteUnlock();
+        }
+    };
 }
 
 NavMeshRuntime::NavMeshRuntime(const NavMeshProperties& properties)
@@ -30,14 +57,87 @@ NavMeshRuntime::NavMeshRuntime(const NavMeshProperties& properties)
     , Properties(properties)
 {
     _navMesh = nullptr;
-    _navMeshQuery = dtAllocNavMeshQuery();
     _tileSize = 0;
 }
 
 NavMeshRuntime::~NavMeshRuntime()
 {
     Dispose();
-    dtFreeNavMeshQuery(_navMeshQuery);
+    Array<dtNavMeshQuery*, InlinedAllocation<64>> queries;
+    _queries.GetValues(queries);
+    for (dtNavMeshQuery* query : queries)
+    {
+        if (query)
+            dtFreeNavMeshQuery(query);
+    }
+}
+
+void NavMeshRuntime::InitFilter(dtQueryFilter& filter)
+{
+    Platform::MemoryCopy(filter.m_areaCost, NavAreasCosts, sizeof(NavAreasCosts));
+    static_assert(sizeof(dtQueryFilter::m_areaCost) == sizeof(NavAreasCosts), "Invalid navmesh area cost list.");
+}
+
+dtNavMeshQuery* NavMeshRuntime::GetNavMeshQuery() const
+{
+    dtNavMeshQuery*& query = _queries.Get();
+    if (!query)
+        query = dtAllocNavMeshQuery();
+    if (_navMesh && query->getAttachedNavMesh() != _navMesh)
+    {
+        // Initialize query for the current navmesh (created after the query)
+        if (dtStatusFailed(query->init(_navMesh, MAX_NODES)))
+            LOG(Error, "Failed to initialize navmesh {0} query.", Properties.Name);
+    }
+    return query;
+}
+
+void NavMeshRuntime::ReadLock() const
+{
+    while (true)
+    {
+        const int64 state = Platform::AtomicRead(&_readers);
+        if (state & NAV_MESH_WRITER_FLAG)
+        {
+            // Wait for the navmesh modification to end
+            ScopeLock lock(_waitLocker);
+            while (Platform::AtomicRead(&_readers) & NAV_MESH_WRITER_FLAG)
+                _waitSignal.Wait(_waitLocker);
+            continue;
+        }
+        if (Platform::InterlockedCompareExchange(&_readers, state + 1, state) == state)
+            break;
+    }
+}
+
+void NavMeshRuntime::ReadUnlock() const
+{
+    if (Platform::InterlockedDecrement(&_readers) == NAV_MESH_WRITER_FLAG)
+    {
+        // Wake up the writer waiting for the last reader
+        ScopeLock lock(_waitLocker);
+        _waitSignal.NotifyAll();
+    }
+}
+
+void NavMeshRuntime::WriteLock()
+{
+    // Writers are serialized by Locker so only the first one sets the flag (nested calls are from the same thread)
+    if (_writeDepth++ != 0)
+        return;
+    Platform::InterlockedAdd(&_readers, NAV_MESH_WRITER_FLAG);
+    ScopeLock lock(_waitLocker);
+    while (Platform::AtomicRead(&_readers) != NAV_MESH_WRITER_FLAG)
+        _waitSignal.Wait(_waitLocker);
+}
+
+void NavMeshRuntime::WriteUnlock()
+{
+    if (--_writeDepth != 0)
+        return;
+    ScopeLock lock(_waitLocker);
+    Platform::InterlockedAdd(&_readers, -NAV_MESH_WRITER_FLAG);
+    _waitSignal.NotifyAll();
 }
 
 int32 NavMeshRuntime::GetTilesCapacity() const
@@ -47,7 +147,7 @@ int32 NavMeshRuntime::GetTilesCapacity() const
 
 bool NavMeshRuntime::FindDistanceToWall(const Vector3& startPosition, NavMeshHit& hitInfo, float maxDistance) const
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -84,7 +184,7 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
 {
     resultPath.Clear();
     resultFlags = NavMeshPathFlags::None;
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -152,7 +252,7 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
 
 bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPosition) const
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -196,7 +296,7 @@ bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPo
 
 bool NavMeshRuntime::FindClosestPoint(const Vector3& point, Vector3& result) const
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -225,7 +325,7 @@ bool NavMeshRuntime::FindClosestPoint(const Vector3& point, Vector3& result) con
 
 bool NavMeshRuntime::FindRandomPoint(Vector3& result) const
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -250,7 +350,7 @@ bool NavMeshRuntime::FindRandomPoint(Vector3& result) const
 
 bool NavMeshRuntime::FindRandomPointAroundCircle(const Vector3& center, float radius, Vector3& result) const
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -286,7 +386,7 @@ bool NavMeshRuntime::FindRandomPointAroundCircle(const Vector3& center, float ra
 
 bool NavMeshRuntime::RayCast(const Vector3& startPosition, const Vector3& endPosition, NavMeshHit& hitInfo) const
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const auto query = GetNavMeshQuery();
     if (!query || !_navMesh)
         return false;
@@ -328,6 +428,7 @@ bool NavMeshRuntime::RayCast(const Vector3& startPosition, const Vector3& endPos
 void NavMeshRuntime::SetTileSize(float tileSize)
 {
     ScopeLock lock(Locker);
+    WriteScopeLock writeLock(this);
 
     // Skip if the same or invalid
     if (Math::NearEqual(_tileSize, tileSize) || tileSize < 1)
@@ -357,16 +458,22 @@ void NavMeshRuntime::EnsureCapacity(int32 tilesToAddCount)
         newCapacity = Math::RoundUpToPowerOf2(newCapacity + 1);
 
     LOG(Info, "Resizing navmesh {2} from {0} to {1} tiles capacity", capacity, newCapacity, Properties.Name);
+    WriteScopeLock writeLock(this);
 
     // Ensure to have size assigned
     ASSERT(_tileSize != 0);
 
-    // Allocate navmesh and initialize the default query
+    // Allocate navmesh and initialize the queries of all threads
     if (!_navMesh)
         _navMesh = dtAllocNavMesh();
-    if (dtStatusFailed(_navMeshQuery->init(_navMesh, MAX_NODES)))
+    Array<dtNavMeshQuery*, InlinedAllocation<64>> queries;
+    _queries.GetValues(queries);
+    for (dtNavMeshQuery* query : queries)
     {
-        LOG(Error, "Failed to initialize navmesh {0}.", Properties.Name);
+        if (query && dtStatusFailed(query->init(_navMesh, MAX_NODES)))
+        {
+            LOG(Error, "Failed to initialize navmesh {0}.", Properties.Name);
+        }
     }
 
     // Prepare parameters
@@ -418,6 +525,7 @@ void NavMeshRuntime::AddTiles(NavMesh* navMesh)
     auto& data = navMesh->Data;
     PROFILE_CPU_NAMED("NavMeshRuntime.AddTiles");
     ScopeLock lock(Locker);
+    WriteScopeLock writeLock(this);
 
     // Validate data (must match navmesh) or init navmesh to match the tiles options
     if (_navMesh)
@@ -449,6 +557,7 @@ void NavMeshRuntime::AddTile(NavMesh* navMesh, NavMeshTileData& tileData)
     auto& data = navMesh->Data;
     PROFILE_CPU_NAMED("NavMeshRuntime.AddTile");
     ScopeLock lock(Locker);
+    WriteScopeLock writeLock(this);
 
     // Validate data (must match navmesh) or init navmesh to match the tiles options
     if (_navMesh)
@@ -487,6 +596,7 @@ void NavMeshRuntime::RemoveTile(int32 x, int32 y, int32 layer)
     if (!_navMesh)
         return;
     PROFILE_CPU_NAMED("NavMeshRuntime.RemoveTile");
+    WriteScopeLock writeLock(this);
 
     const auto tileRef = _navMesh->getTileRefAt(x, y, layer);
     if (tileRef == 0)
@@ -517,6 +627,7 @@ void NavMeshRuntime::RemoveTiles(bool (*prediction)(const NavMeshRuntime* navMes
     if (!_navMesh)
         return;
     PROFILE_CPU_NAMED("NavMeshRuntime.RemoveTiles");
+    WriteScopeLock writeLock(this);
 
     for (int32 i = 0; i < _tiles.Count(); i++)
     {
@@ -618,7 +729,7 @@ void DrawPoly(NavMeshRuntime* navMesh, const Matrix& navMeshToWorld, const dtMes
 
 void NavMeshRuntime::DebugDraw()
 {
-    ScopeLock lock(Locker);
+    ReadScopeLock lock(this);
     const dtNavMesh* dtNavMesh = GetNavMesh();
     const int tilesCount = dtNavMesh ? dtNavMesh->getMaxTiles() : 0;
     if (tilesCount == 0)
@@ -650,6 +761,8 @@ void NavMeshRuntime::DebugDraw()
 
 void NavMeshRuntime::Dispose()
 {
+    ScopeLock lock(Locker);
+    WriteScopeLock writeLock(this);
     if (_navMesh)
     {
         dtFreeNavMesh(_navMesh);
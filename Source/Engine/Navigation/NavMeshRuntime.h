@@ -4,12 +4,15 @@
 
 #include "Engine/Core/Types/BaseTypes.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/ConditionVariable.h"
 #include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Threading/ThreadLocal.h"
 #include "NavMeshData.h"
 #include "NavigationTypes.h"
 
 class dtNavMesh;
 class dtNavMeshQuery;
+class dtQueryFilter;
 class NavMesh;
 
 /// <summary>
@@ -63,9 +66,16 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
     static Color NavAreasColors[64];
 #endif
 
+    // Initializes the navmesh query filter with the current areas costs.
+    static void InitFilter(dtQueryFilter& filter);
+
 private:
     dtNavMesh* _navMesh;
-    dtNavMeshQuery* _navMeshQuery;
+    mutable ThreadLocal<dtNavMeshQuery*> _queries; // Each thread uses own query object to run navmesh queries in parallel
+    mutable volatile int64 _readers = 0; // Amount of the active readers and the writer flag (see ReadLock and WriteLock)
+    int32 _writeDepth = 0;
+    mutable CriticalSection _waitLocker;
+    mutable ConditionVariable _waitSignal;
     float _tileSize;
     Array<NavMeshTile> _tiles;
 
@@ -75,7 +85,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
 
 public:
     /// <summary>
-    /// The object locker.
+    /// The object locker. Used when modifying the navmesh (eg. adding or removing tiles). Queries don't use it (see ReadLock and WriteLock).
     /// </summary>
     CriticalSection Locker;
 
@@ -97,10 +107,30 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
         return _navMesh;
     }
 
-    dtNavMeshQuery* GetNavMeshQuery() const
-    {
-        return _navMeshQuery;
-    }
+    /// <summary>
+    /// Gets the navmesh query object for the current thread. Use it only within ReadLock/ReadUnlock.
+    /// </summary>
+    dtNavMeshQuery* GetNavMeshQuery() const;
+
+    /// <summary>
+    /// Locks the navmesh for reading (eg. to run queries). Multiple threads can read the navmesh at once without locking, readers wait only while the navmesh is being modified (see WriteLock).
+    /// </summary>
+    void ReadLock() const;
+
+    /// <summary>
+    /// Unlocks the navmesh after reading.
+    /// </summary>
+    void ReadUnlock() const;
+
+    /// <summary>
+    /// Locks the navmesh for writing. Blocks new readers and waits for the active ones to end. Must be called with Locker held (can be nested).
+    /// </summary>
+    void WriteLock();
+
+    /// <summary>
+    /// Unlocks the navmesh after writing and wakes up the waiting readers.
+    /// </summary>
+    void WriteUnlock();
 
     int32 GetTilesCapacity() const;
 
@@ -8,6 +8,7 @@
 #include "Engine/Content/Content.h"
 #include "Engine/Content/JsonAsset.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
 #include "Editor/Managed/ManagedEditor.h"
@@ -20,11 +21,254 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/Serialization.h"
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
+#include <ThirdParty/recastnavigation/DetourNavMeshQuery.h>
 #include <ThirdParty/recastnavigation/RecastAlloc.h>
 
+// Maximum amount of paths searched at once by the asynchronous paths requests (each uses own navmesh query, other paths wait for the free one)
+#define NAVIGATION_PATH_QUERIES 64
+// Size of the nodes pool of the navmesh query used by the asynchronous paths requests
+#define NAVIGATION_PATH_QUERY_NODES 2048
+// Minimum amount of path finding iterations done for a single path per update (limits the amount of paths processed at once within the iterations budget)
+#define NAVIGATION_PATH_MIN_ITERATIONS 32
+
 namespace
 {
     Array<NavMeshRuntime*, InlinedAllocation<16>> NavMeshes;
+
+    enum class PathState : byte
+    {
+        Pending,
+        InProgress,
+        Done,
+        Failed,
+    };
+
+    struct PathRequestItem
+    {
+        Vector3 StartPosition;
+        Vector3 EndPosition;
+        Float3 StartPositionNavMesh;
+        Float3 EndPositionNavMesh;
+        dtPolyRef StartPoly;
+        dtNavMeshQuery* Query;
+        PathState State;
+        Array<Vector3, HeapAllocation> Path;
+    };
+
+    struct PathRequest
+    {
+        uint64 Handle;
+        String NavMeshName; // Navmesh runtime is resolved on each update as it can be removed while paths are pending
+        dtQueryFilter Filter;
+        Array<PathRequestItem> Items;
+        bool Done;
+        bool Released;
+    };
+
+    struct PathJobItem
+    {
+        NavMeshRuntime* NavMesh;
+        PathRequest* Request;
+        PathRequestItem* Item;
+    };
+
+    CriticalSection PathRequestsLocker;
+    Array<PathRequest*> PathRequests;
+    Array<PathJobItem> PathJobItems;
+    Array<dtNavMeshQuery*> PathQueriesPool;
+    int32 PathQueriesCount = 0;
+    uint64 PathRequestsCounter = 0;
+    int64 PathJobsLabel = 0;
+    int32 PathJobIterations = 0;
+
+    PathRequest* GetPathRequest(uint64 handle)
+    {
+        for (PathRequest* request : PathRequests)
+        {
+            if (request->Handle == handle)
+                return request;
+        }
+        return nullptr;
+    }
+
+    PathState ProcessPath(const NavMeshRuntime* navMeshRuntime, const PathRequest& request, PathRequestItem& item)
+    {
+        const NavMeshProperties& properties = navMeshRuntime->Properties;
+        const dtNavMesh* navMesh = navMeshRuntime->GetNavMesh();
+        dtNavMeshQuery* query = item.Query;
+        if (!navMesh)
+            return PathState::Failed;
+        if (item.State == PathState::Pending)
+        {
+            if (query->getAttachedNavMesh() != navMesh && dtStatusFailed(query->init(navMesh, NAVIGATION_PATH_QUERY_NODES)))
+                return PathState::Failed;
+
+            Float3 extent = properties.DefaultQueryExtent;
+            Float3::Transform(item.StartPosition, properties.Rotation, item.StartPositionNavMesh);
+            Float3::Transform(item.EndPosition, properties.Rotation, item.EndPositionNavMesh);
+            item.StartPoly = 0;
+            query->findNearestPoly(&item.StartPositionNavMesh.X, &extent.X, &request.Filter, &item.StartPoly, nullptr);
+            dtPolyRef endPoly = 0;
+            query->findNearestPoly(&item.EndPositionNavMesh.X, &extent.X, &request.Filter, &endPoly, nullptr);
+            if (!item.StartPoly || !endPoly)
+                return PathState::Failed;
+
+            if (dtStatusFailed(query->initSlicedFindPath(item.StartPoly, endPoly, &item.StartPositionNavMesh.X, &item.EndPositionNavMesh.X, &request.Filter)))
+                return PathState::Failed;
+        }
+        else if (query->getAttachedNavMesh() != navMesh)
+        {
+            // Navmesh has been recreated during the search
+            return PathState::Failed;
+        }
+
+        // Continue the search (removed tiles are detected by the query and fail the path)
+        const dtStatus updateStatus = query->updateSlicedFindPath(PathJobIterations, nullptr);
+        if (dtStatusInProgress(updateStatus))
+            return PathState::InProgress;
+        if (dtStatusFailed(updateStatus))
+            return PathState::Failed;
+
+        dtPolyRef path[NAV_MESH_PATH_MAX_SIZE];
+        int32 pathSize;
+        const dtStatus findPathStatus = query->finalizeSlicedFindPath(path, &pathSize, NAV_MESH_PATH_MAX_SIZE);
+        if (dtStatusFailed(findPathStatus))
+            return PathState::Failed;
+
+        Quaternion invRotation;
+        Quaternion::Invert(properties.Rotation, invRotation);
+
+        if (pathSize == 1 && dtStatusDetail(findPathStatus, DT_PARTIAL_RESULT))
+        {
+            item.Path.Resize(2);
+            item.Path[0] = item.StartPosition;
+            query->closestPointOnPolyBoundary(item.StartPoly, &item.EndPositionNavMesh.X, &item.EndPositionNavMesh.X);
+            Vector3::Transform(item.EndPositionNavMesh, invRotation, item.Path[1]);
+        }
+        else
+        {
+            int pathPointsCount = 0;
+            Float3 pathPoints[NAV_MESH_PATH_MAX_SIZE];
+            if (dtStatusFailed(query->findStraightPath(&item.StartPositionNavMesh.X, &item.EndPositionNavMesh.X, path, pathSize, (float*)&pathPoints, nullptr, nullptr, &pathPointsCount, NAV_MESH_PATH_MAX_SIZE, DT_STRAIGHTPATH_AREA_CROSSINGS)))
+                return PathState::Failed;
+            item.Path.Resize(pathPointsCount);
+            for (int32 i = 0; i < pathPointsCount; i++)
+                Vector3::Transform(pathPoints[i], invRotation, item.Path[i]);
+        }
+        return PathState::Done;
+    }
+
+    void ProcessPathJob(int32 index)
+    {
+        const PathJobItem& e = PathJobItems[index];
+        e.NavMesh->ReadLock();
+        e.Item->State = ProcessPath(e.NavMesh, *e.Request, *e.Item);
+        e.NavMesh->ReadUnlock();
+    }
+
+    void UpdatePathRequests()
+    {
+        // Paths processed during the last frame are ready now
+        if (PathJobsLabel != 0)
+        {
+            JobSystem::Wait(PathJobsLabel);
+            PathJobsLabel = 0;
+        }
+        ScopeLock lock(PathRequestsLocker);
+        PathJobItems.Clear();
+        if (PathRequests.IsEmpty())
+            return;
+        PROFILE_CPU_NAMED("Navigation.Paths");
+
+        for (int32 i = 0; i < PathRequests.Count(); i++)
+        {
+            PathRequest* request = PathRequests[i];
+            const bool hasNavMesh = NavMeshRuntime::Get(request->NavMeshName) != nullptr;
+            bool done = true;
+            for (PathRequestItem& item : request->Items)
+            {
+                if (!hasNavMesh && item.State != PathState::Done)
+                {
+                    // Navmesh has been removed
+                    item.State = PathState::Failed;
+                }
+                const bool finished = item.State == PathState::Done || item.State == PathState::Failed;
+                if (item.Query && (finished || request->Released))
+                {
+                    PathQueriesPool.Add(item.Query);
+                    item.Query = nullptr;
+                }
+                done &= finished;
+            }
+            if (request->Released)
+            {
+                PathRequests.RemoveAtKeepOrder(i--);
+                Delete(request);
+                continue;
+            }
+            request->Done = done;
+        }
+
+        // Pick paths to process in order of requests (paths without a free query or above the iterations budget wait for the next update)
+        const int32 iterationsBudget = Math::Max(Navigation::PathIterationsPerUpdate, 1);
+        const int32 maxPaths = Math::Max(iterationsBudget / NAVIGATION_PATH_MIN_ITERATIONS, 1);
+        for (PathRequest* request : PathRequests)
+        {
+            if (request->Done)
+                continue;
+            NavMeshRuntime* navMesh = NavMeshRuntime::Get(request->NavMeshName);
+            for (PathRequestItem& item : request->Items)
+            {
+                if (PathJobItems.Count() == maxPaths)
+                    break;
+                if (item.State == PathState::Pending && !item.Query)
+                {
+                    if (PathQueriesPool.HasItems())
+                        item.Query = PathQueriesPool.Pop();
+                    else if (PathQueriesCount < NAVIGATION_PATH_QUERIES)
+                    {
+                        item.Query = dtAllocNavMeshQuery();
+                        PathQueriesCount++;
+                    }
+                    else
+                        continue;
+                }
+                if (item.Query)
+                    PathJobItems.Add({ navMesh, request, &item });
+            }
+        }
+        if (PathJobItems.HasItems())
+        {
+            // Split the iterations budget between the paths
+            PathJobIterations = Math::Max(iterationsBudget / PathJobItems.Count(), 1);
+            PathJobsLabel = JobSystem::Dispatch(ProcessPathJob, PathJobItems.Count());
+        }
+    }
+
+    void ReleasePathRequests()
+    {
+        if (PathJobsLabel != 0)
+        {
+            JobSystem::Wait(PathJobsLabel);
+            PathJobsLabel = 0;
+        }
+        ScopeLock lock(PathRequestsLocker);
+        PathJobItems.Clear();
+        for (PathRequest* request : PathRequests)
+        {
+            for (PathRequestItem& item : request->Items)
+            {
+                if (item.Query)
+                    PathQueriesPool.Add(item.Query);
+            }
+            Delete(request);
+        }
+        PathRequests.Clear();
+        for (dtNavMeshQuery* query : PathQueriesPool)
+            dtFreeNavMeshQuery(query);
+        PathQueriesPool.Clear();
+        PathQueriesCount = 0;
+    }
 }
 
 NavMeshRuntime* NavMeshRuntime::Get()
@@ -168,9 +412,7 @@ class NavigationService : public EngineService
     }
 
     bool Init() override;
-#if COMPILE_WITH_NAV_MESH_BUILDER
     void Update() override;
-#endif
     void Dispose() override;
 };
 
@@ -283,17 +525,18 @@ bool NavigationService::Init()
     return false;
 }
 
-#if COMPILE_WITH_NAV_MESH_BUILDER
-
 void NavigationService::Update()
 {
+    UpdatePathRequests();
+#if COMPILE_WITH_NAV_MESH_BUILDER
     NavMeshBuilder::Update();
-}
-
 #endif
+}
 
 void NavigationService::Dispose()
 {
+    ReleasePathRequests();
+
     // Release nav meshes
     for (auto navMesh : NavMeshes)
     {
@@ -325,6 +568,73 @@ bool Navigation::TestPath(const Vector3& startPosition, const Vector3& endPositi
     return NavMeshes.First()->TestPath(startPosition, endPosition);
 }
 
+int32 Navigation::PathIterationsPerUpdate = 512;
+
+uint64 Navigation::RequestPaths(const Array<Vector3, HeapAllocation>& startPositions, const Array<Vector3, HeapAllocation>& endPositions)
+{
+    if (NavMeshes.IsEmpty() || startPositions.IsEmpty() || startPositions.Count() != endPositions.Count())
+        return 0;
+    auto request = New<PathRequest>();
+    request->NavMeshName = NavMeshes.First()->Properties.Name;
+    NavMeshRuntime::InitFilter(request->Filter);
+    request->Items.Resize(startPositions.Count());
+    for (int32 i = 0; i < startPositions.Count(); i++)
+    {
+        PathRequestItem& item = request->Items[i];
+        item.StartPosition = startPositions[i];
+        item.EndPosition = endPositions[i];
+        item.StartPoly = 0;
+        item.Query = nullptr;
+        item.State = PathState::Pending;
+    }
+    request->Done = false;
+    request->Released = false;
+    ScopeLock lock(PathRequestsLocker);
+    request->Handle = ++PathRequestsCounter;
+    PathRequests.Add(request);
+    return request->Handle;
+}
+
+bool Navigation::IsPathsRequestDone(uint64 handle)
+{
+    ScopeLock lock(PathRequestsLocker);
+    const PathRequest* request = GetPathRequest(handle);
+    return request && request->Done;
+}
+
+bool Navigation::GetRequestedPath(uint64 handle, int32 index, Array<Vector3, HeapAllocation>& resultPath)
+{
+    resultPath.Clear();
+    ScopeLock lock(PathRequestsLocker);
+    const PathRequest* request = GetPathRequest(handle);
+    if (!request || !request->Done || index < 0 || index >= request->Items.Count())
+        return false;
+    const PathRequestItem& item = request->Items[index];
+    if (item.State != PathState::Done)
+        return false;
+    resultPath = item.Path;
+    return true;
+}
+
+void Navigation::ReleasePaths(uint64 handle)
+{
+    ScopeLock lock(PathRequestsLocker);
+    PathRequest* request = GetPathRequest(handle);
+    if (!request)
+        return;
+    if (request->Done)
+    {
+        // Done requests are not used by the jobs
+        PathRequests.Remove(request);
+        Delete(request);
+    }
+    else
+    {
+        // Delete after the jobs end
+        request->Released = true;
+    }
+}
+
 bool Navigation::FindClosestPoint(const Vector3& point, Vector3& result)
 {
     if (NavMeshes.IsEmpty())
@@ -39,6 +39,42 @@ API_CLASS(Static) class FLAXENGINE_API Navigation
     /// <returns>True if found valid path between given two points, otherwise false if failed.</returns>
     API_FUNCTION() static bool TestPath(const Vector3& startPosition, const Vector3& endPosition);
 
+public:
+    /// <summary>
+    /// The maximum amount of path finding iterations (visited navmesh nodes) done for all asynchronous paths requests per update (split between the paths in progress). Longer paths are continued in the next updates.
+    /// </summary>
+    API_FIELD() static int32 PathIterationsPerUpdate;
+
+    /// <summary>
+    /// Requests finding the paths between the pairs of positions. Paths are searched asynchronously on Job System threads (over multiple updates for long paths) and results are available from the next update. Use IsPathsRequestDone to check the state, GetRequestedPath to read the result and ReleasePaths to free the request.
+    /// </summary>
+    /// <param name="startPositions">The start positions.</param>
+    /// <param name="endPositions">The end positions (the same amount as the start positions).</param>
+    /// <returns>The request handle or 0 if failed.</returns>
+    API_FUNCTION() static uint64 RequestPaths(const Array<Vector3, HeapAllocation>& startPositions, const Array<Vector3, HeapAllocation>& endPositions);
+
+    /// <summary>
+    /// Checks if all paths of the request have been processed.
+    /// </summary>
+    /// <param name="handle">The request handle.</param>
+    /// <returns>True if results are ready, otherwise false if request is still in progress or handle is invalid.</returns>
+    API_FUNCTION() static bool IsPathsRequestDone(uint64 handle);
+
+    /// <summary>
+    /// Gets the path found by the request. Valid only when request is done.
+    /// </summary>
+    /// <param name="handle">The request handle.</param>
+    /// <param name="index">The path index (the same as the index of the positions pair passed to RequestPaths).</param>
+    /// <param name="resultPath">The result path.</param>
+    /// <returns>True if found valid path between given two points (it may be partial), otherwise false if failed.</returns>
+    API_FUNCTION() static bool GetRequestedPath(uint64 handle, int32 index, API_PARAM(Out) Array<Vector3, HeapAllocation>& resultPath);
+
+    /// <summary>
+    /// Releases the paths request. Request in progress is cancelled.
+    /// </summary>
+    /// <param name="handle">The request handle.</param>
+    API_FUNCTION() static void ReleasePaths(uint64 handle);
+
     /// <summary>
     /// Finds the nearest point on a nav mesh surface.
     /// </summary>
@@ -82,6 +82,16 @@ API_STRUCT(Namespace="FlaxEngine.Networking") struct FLAXENGINE_API NetworkConfi
     API_FIELD()
     uint16 MessagePoolSize = 2048;
 
+    /// <summary>
+    /// Enables batching multiple small messages sent over the same channel to the same connection into a single packet (up to MessageSize bytes). Reduces the amount of packets sent when many small messages are sent at once (eg. objects replication).
+    /// </summary>
+    /// <remarks>
+    /// Must be the same on the server and on all clients. Batched messages are sent when calling NetworkPeer.Flush (done by NetworkManager at the end of each network update).
+    /// Messages too large to fit into a batch are sent directly, so they cannot start with byte 0xFF (reserved for the batches) when batching is enabled.
+    /// </remarks>
+    API_FIELD()
+    bool MessageBatching = false;
+
     // Ignore deprecation warnings in defaults
     PRAGMA_DISABLE_DEPRECATION_WARNINGS
     NetworkConfig()
@@ -19,6 +19,8 @@ enum class NetworkMessageIDs : uint8
     ObjectDespawn,
     ObjectRole,
     ObjectRpc,
+    ObjectIds,
+    ObjectReplicateAck,
 
     MAX,
 };
@@ -38,6 +40,8 @@ class NetworkInternal
     static void OnNetworkMessageObjectDespawn(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRole(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectIds(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
 
 #if COMPILE_WITH_PROFILER
 
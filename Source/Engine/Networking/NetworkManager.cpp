@@ -15,7 +15,7 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Scripting/Scripting.h"
 
-#define NETWORK_PROTOCOL_VERSION 3
+#define NETWORK_PROTOCOL_VERSION 5
 
 float NetworkManager::NetworkFPS = 60.0f;
 NetworkPeer* NetworkManager::Peer = nullptr;
@@ -135,6 +135,8 @@ namespace
         NetworkInternal::OnNetworkMessageObjectDespawn,
         NetworkInternal::OnNetworkMessageObjectRole,
         NetworkInternal::OnNetworkMessageObjectRpc,
+        NetworkInternal::OnNetworkMessageObjectIds,
+        NetworkInternal::OnNetworkMessageObjectReplicateAck,
     };
 }
 
@@ -181,6 +183,7 @@ bool StartPeer()
         networkConfig.Port = settings.Port;
         networkConfig.ConnectionsLimit = (uint16)settings.MaxClients;
     }
+    networkConfig.MessageBatching = settings.MessageBatching;
     const ScriptingTypeHandle networkDriverType = Scripting::FindScriptingType(settings.NetworkDriver);
     if (!networkDriverType)
     {
@@ -481,4 +484,7 @@ void NetworkManagerService::Update()
 
     // Update replication
     NetworkInternal::NetworkReplicatorUpdate();
+
+    // Send batched messages
+    peer->Flush();
 }
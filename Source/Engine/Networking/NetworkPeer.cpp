@@ -2,12 +2,18 @@
 
 #include "NetworkPeer.h"
 #include "NetworkEvent.h"
+#include "NetworkChannelType.h"
 #include "Drivers/ENetDriver.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Platform/CPUInfo.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 
+// The first byte of the packet with batched messages (each message is prefixed with uint16 length). When batching is enabled, only messages too large for a batch are sent without it.
+#define NETWORK_PEER_BATCH_MARKER 0xFF
+#define NETWORK_PEER_BATCH_HEADER_SIZE sizeof(uint8)
+#define NETWORK_PEER_BATCH_MESSAGE_HEADER_SIZE sizeof(uint16)
+
 Array<NetworkPeer*> NetworkPeer::Peers;
 
 namespace
@@ -75,6 +81,8 @@ bool NetworkPeer::Initialize(const NetworkConfig& config)
 
 void NetworkPeer::Shutdown()
 {
+    _batches.Clear();
+    _receivedBatch = NetworkMessage();
     NetworkDriver->Dispose();
     Delete(Config.NetworkDriver);
     DisposeMessageBuffers();
@@ -122,19 +130,61 @@ bool NetworkPeer::Connect()
 void NetworkPeer::Disconnect()
 {
     LOG(Info, "Disconnecting...");
+    Flush();
     NetworkDriver->Disconnect();
 }
 
 void NetworkPeer::Disconnect(const NetworkConnection& connection)
 {
     LOG(Info, "Disconnecting connection with id = {0}...", connection.ConnectionId);
+    Flush();
     NetworkDriver->Disconnect(connection);
 }
 
 bool NetworkPeer::PopEvent(NetworkEvent& eventRef)
 {
     PROFILE_CPU();
-    return NetworkDriver->PopEvent(eventRef);
+    while (true)
+    {
+        if (_receivedBatch.IsValid())
+        {
+            // Split the next message from the received batch
+            if (_receivedBatch.Position + NETWORK_PEER_BATCH_MESSAGE_HEADER_SIZE <= _receivedBatch.Length)
+            {
+                const uint16 length = _receivedBatch.ReadUInt16();
+                if (_receivedBatch.Position + length <= _receivedBatch.Length)
+                {
+                    eventRef.EventType = NetworkEventType::Message;
+                    eventRef.Sender = _receivedBatchSender;
+                    eventRef.Message = CreateMessage();
+                    eventRef.Message.Length = length;
+                    Platform::MemoryCopy(eventRef.Message.Buffer, _receivedBatch.Buffer + _receivedBatch.Position, length);
+                    _receivedBatch.Position += length;
+                    _stats.MessagesReceived++;
+                    return true;
+                }
+                LOG(Warning, "Invalid batched message from connection {0}", _receivedBatchSender.ConnectionId);
+            }
+            RecycleMessage(_receivedBatch);
+            _receivedBatch = NetworkMessage();
+        }
+
+        if (!NetworkDriver->PopEvent(eventRef))
+            return false;
+        if (eventRef.EventType != NetworkEventType::Message)
+            return true;
+        _stats.PacketsReceived++;
+        if (Config.MessageBatching && eventRef.Message.Length >= NETWORK_PEER_BATCH_HEADER_SIZE && eventRef.Message.Buffer[0] == NETWORK_PEER_BATCH_MARKER)
+        {
+            // Return batched messages one by one
+            _receivedBatch = eventRef.Message;
+            _receivedBatch.Position = NETWORK_PEER_BATCH_HEADER_SIZE;
+            _receivedBatchSender = eventRef.Sender;
+            continue;
+        }
+        _stats.MessagesReceived++;
+        return true;
+    }
 }
 
 NetworkMessage NetworkPeer::CreateMessage()
@@ -170,32 +220,147 @@ bool NetworkPeer::EndSendMessage(const NetworkChannelType channelType, const Net
 {
     ASSERT(message.IsValid());
 
-    NetworkDriver->SendMessage(channelType, message);
+    bool failed = false;
+    if (Config.MessageBatching)
+        failed = BatchMessage(channelType, message, nullptr);
+    else
+        SendMessage(channelType, message, nullptr);
+    if (!failed)
+        _stats.MessagesSent++;
 
     RecycleMessage(message);
-    return false;
+    return failed;
 }
 
 bool NetworkPeer::EndSendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const NetworkConnection& target)
 {
     ASSERT(message.IsValid());
 
-    NetworkDriver->SendMessage(channelType, message, target);
+    bool failed = false;
+    if (Config.MessageBatching)
+        failed = BatchMessage(channelType, message, &target);
+    else
+        SendMessage(channelType, message, &target);
+    if (!failed)
+        _stats.MessagesSent++;
 
     RecycleMessage(message);
-    return false;
+    return failed;
 }
 
 bool NetworkPeer::EndSendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection>& targets)
 {
     ASSERT(message.IsValid());
 
-    NetworkDriver->SendMessage(channelType, message, targets);
+    bool failed = false;
+    if (Config.MessageBatching)
+    {
+        for (const NetworkConnection& target : targets)
+        {
+            if (BatchMessage(channelType, message, &target))
+            {
+                failed = true;
+                break;
+            }
+            _stats.MessagesSent++;
+        }
+    }
+    else
+    {
+        NetworkDriver->SendMessage(channelType, message, targets);
+        _stats.PacketsSent += targets.Count();
+        _stats.MessagesSent += targets.Count();
+    }
 
     RecycleMessage(message);
+    return failed;
+}
+
+void NetworkPeer::Flush()
+{
+    if (_batches.IsEmpty())
+        return;
+    PROFILE_CPU();
+    for (MessageBatch& batch : _batches)
+        FlushBatch(batch);
+    _batches.Clear();
+}
+
+void NetworkPeer::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const NetworkConnection* target)
+{
+    if (target)
+        NetworkDriver->SendMessage(channelType, message, *target);
+    else
+        NetworkDriver->SendMessage(channelType, message);
+    _stats.PacketsSent++;
+}
+
+bool NetworkPeer::BatchMessage(const NetworkChannelType channelType, const NetworkMessage& message, const NetworkConnection* target)
+{
+    // Find the batch for the channel and target
+    MessageBatch* batch = nullptr;
+    for (MessageBatch& e : _batches)
+    {
+        if (e.ChannelType == channelType && e.HasTarget == (target != nullptr) && (!target || e.Target == *target))
+        {
+            batch = &e;
+            break;
+        }
+    }
+    const uint32 size = NETWORK_PEER_BATCH_MESSAGE_HEADER_SIZE + message.Length;
+    if (NETWORK_PEER_BATCH_HEADER_SIZE + size > Config.MessageSize)
+    {
+        // Message is too large to be batched so send it directly (after any earlier messages to keep the order)
+        if (message.Buffer[0] == NETWORK_PEER_BATCH_MARKER)
+        {
+            // Receiver would treat it as a batch
+            LOG(Error, "Cannot send message of size {0} that starts with byte 0xFF reserved for messages batching. Reduce the message size or change its first byte.", message.Length);
+            return true;
+        }
+        if (batch)
+            FlushBatch(*batch);
+        SendMessage(channelType, message, target);
+        return false;
+    }
+    if (!batch)
+    {
+        batch = &_batches.AddOne();
+        batch->ChannelType = channelType;
+        batch->HasTarget = target != nullptr;
+        if (target)
+            batch->Target = *target;
+        batch->MessagesCount = 0;
+    }
+    else if (batch->MessagesCount != 0 && batch->Message.Length + size > Config.MessageSize)
+    {
+        // Batch is full
+        FlushBatch(*batch);
+    }
+
+    // Append message to the batch
+    if (batch->MessagesCount == 0)
+    {
+        batch->Message = CreateMessage();
+        batch->Message.WriteUInt8(NETWORK_PEER_BATCH_MARKER);
+    }
+    batch->Message.WriteUInt16((uint16)message.Length);
+    batch->Message.WriteBytes(message.Buffer, (int32)message.Length);
+    batch->MessagesCount++;
     return false;
 }
 
+void NetworkPeer::FlushBatch(MessageBatch& batch)
+{
+    if (batch.MessagesCount == 0)
+        return;
+    // Always send with the batch header (even a single message) so the receiver never confuses user data with the batch marker
+    SendMessage(batch.ChannelType, batch.Message, batch.HasTarget ? &batch.Target : nullptr);
+    _stats.PacketsSaved += batch.MessagesCount - 1;
+    RecycleMessage(batch.Message);
+    batch.Message = NetworkMessage();
+    batch.MessagesCount = 0;
+}
+
 NetworkPeer* NetworkPeer::CreatePeer(const NetworkConfig& config)
 {
     // Validate the address for listen/connect
@@ -4,6 +4,9 @@
 
 #include "Types.h"
 #include "NetworkConfig.h"
+#include "NetworkMessage.h"
+#include "NetworkConnection.h"
+#include "NetworkStats.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
@@ -25,6 +28,21 @@ API_CLASS(sealed, NoSpawn, Namespace = "FlaxEngine.Networking") class FLAXENGINE
     uint8* MessageBuffer = nullptr;
     Array<uint32, HeapAllocation> MessagePool;
 
+private:
+    struct MessageBatch
+    {
+        NetworkChannelType ChannelType;
+        bool HasTarget;
+        NetworkConnection Target;
+        NetworkMessage Message;
+        int32 MessagesCount;
+    };
+
+    Array<MessageBatch> _batches;
+    NetworkMessage _receivedBatch;
+    NetworkConnection _receivedBatchSender;
+    NetworkPeerStats _stats;
+
 public:
     /// <summary>
     /// Low-level network transport driver used by this peer.
@@ -130,6 +148,20 @@ API_CLASS(sealed, NoSpawn, Namespace = "FlaxEngine.Networking") class FLAXENGINE
     /// </remarks>
     API_FUNCTION() bool EndSendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets);
 
+    /// <summary>
+    /// Sends all messages batched since the last flush. Used only when MessageBatching is enabled in the peer config.
+    /// </summary>
+    /// <remarks>NetworkManager flushes its peer at the end of each network update.</remarks>
+    API_FUNCTION() void Flush();
+
+    /// <summary>
+    /// Gets the peer statistics (messages and packets sent and received).
+    /// </summary>
+    API_FUNCTION() NetworkPeerStats GetStats() const
+    {
+        return _stats;
+    }
+
     /// <summary>
     /// Creates new peer using given configuration.
     /// </summary>
@@ -172,4 +204,7 @@ API_CLASS(sealed, NoSpawn, Namespace = "FlaxEngine.Networking") class FLAXENGINE
     void Shutdown();
     void CreateMessageBuffers();
     void DisposeMessageBuffers();
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const NetworkConnection* target);
+    bool BatchMessage(NetworkChannelType channelType, const NetworkMessage& message, const NetworkConnection* target);
+    void FlushBatch(MessageBatch& batch);
 };
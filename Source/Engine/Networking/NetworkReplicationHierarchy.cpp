@@ -30,6 +30,15 @@ void NetworkReplicationHierarchyUpdateResult::Init()
     ReplicationScale = 1.0f;
 }
 
+void NetworkReplicationHierarchyUpdateResult::AddEntry(const NetworkReplicationHierarchyObject& obj, NetworkClientsMask targetClients)
+{
+    Entry& e = _entries.AddOne();
+    e.Object = obj.Object.Get();
+    e.TargetClients = targetClients;
+    e.Priority = obj.Priority;
+    e.CullDistance = obj.CullDistance;
+}
+
 void NetworkReplicationHierarchyUpdateResult::SetClientLocation(int32 clientIndex, const Vector3& location)
 {
     CHECK(clientIndex >= 0 && clientIndex < _clients.Count());
@@ -106,14 +115,14 @@ void NetworkReplicationNode::Update(NetworkReplicationHierarchyUpdateResult* res
             {
                 // Marked as dirty to sync manually
                 obj.ReplicationUpdatesLeft = 0;
-                result->AddObject(obj.Object);
+                result->AddEntry(obj, NetworkClientsMask::All);
             }
             continue;
         }
         else if (obj.ReplicationFPS < ZeroTolerance) // == 0
         {
             // Always relevant
-            result->AddObject(obj.Object);
+            result->AddEntry(obj, NetworkClientsMask::All);
         }
         else if (obj.ReplicationUpdatesLeft > 0)
         {
@@ -149,7 +158,7 @@ void NetworkReplicationNode::Update(NetworkReplicationHierarchyUpdateResult* res
             if (targetClients && obj.Object)
             {
                 // Replicate this frame
-                result->AddObject(obj.Object, targetClients);
+                result->AddEntry(obj, targetClients);
             }
 
             // Calculate frames until next replication
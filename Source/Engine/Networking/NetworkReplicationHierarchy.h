@@ -24,6 +24,8 @@ API_STRUCT(NoDefault, Namespace = "FlaxEngine.Networking") struct FLAXENGINE_API
     API_FIELD() float ReplicationFPS = 60;
     // The minimum distance from the player to the object at which it can process replication. For example, players further away won't receive object data. Use 0 if unused.
     API_FIELD() float CullDistance = 15000;
+    // The replication priority weight. When the amount of data sent to a client is limited (see NetworkReplicationHierarchy::ClientBudget) then objects with higher priority are replicated first. Priority is scaled down with the distance to the viewer (relative to CullDistance) and accumulated over updates in which object was not sent to the client.
+    API_FIELD() float Priority = 1.0f;
     // Runtime value for update frames left for the next replication of this object. Matches NetworkManager::NetworkFPS calculated from ReplicationFPS. Set to 1 if ReplicationFPS less than 0 to indicate dirty object.
     API_FIELD(Attributes="HideInEditor") uint16 ReplicationUpdatesLeft = 0;
 
@@ -127,6 +129,8 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
     {
         ScriptingObject* Object;
         NetworkClientsMask TargetClients;
+        float Priority;
+        float CullDistance;
     };
 
     bool _clientsHaveLocation;
@@ -135,6 +139,7 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
     Array<Entry> _entries;
 
     void Init();
+    void AddEntry(const NetworkReplicationHierarchyObject& obj, NetworkClientsMask targetClients);
 
 public:
     // Scales the ReplicationFPS property of objects in hierarchy. Can be used to slow down or speed up replication rate.
@@ -146,6 +151,8 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
         Entry& e = _entries.AddOne();
         e.Object = obj;
         e.TargetClients = NetworkClientsMask::All;
+        e.Priority = 1.0f;
+        e.CullDistance = 0.0f;
     }
 
     // Adds object to the update results. Defines specific clients to receive the update (server-only, unused on client). Mask matches NetworkManager::Clients.
@@ -154,6 +161,18 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
         Entry& e = _entries.AddOne();
         e.Object = obj;
         e.TargetClients = targetClients;
+        e.Priority = 1.0f;
+        e.CullDistance = 0.0f;
+    }
+
+    // Adds object to the update results. Defines specific clients to receive the update (server-only, unused on client) and the replication priority weight used when the client bandwidth is limited (see NetworkReplicationHierarchy::ClientBudget).
+    API_FUNCTION() void AddObject(ScriptingObject* obj, NetworkClientsMask targetClients, float priority)
+    {
+        Entry& e = _entries.AddOne();
+        e.Object = obj;
+        e.TargetClients = targetClients;
+        e.Priority = priority;
+        e.CullDistance = 0.0f;
     }
 
     // Gets amount of the clients to use. Matches NetworkManager::Clients.
@@ -268,4 +287,9 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
 API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkReplicationHierarchy : public NetworkReplicationNode
 {
     DECLARE_SCRIPTING_TYPE_WITH_CONSTRUCTOR_IMPL(NetworkReplicationHierarchy, NetworkReplicationNode);
+
+    /// <summary>
+    /// The maximum amount of replicated objects data (in bytes) to send to a single client per network update (server-only). Objects with the highest priority are sent first and the others are delayed to the next updates with increased priority, so crowded areas lower the replication rate instead of flooding the connection. Use 0 for unlimited.
+    /// </summary>
+    API_FIELD() int32 ClientBudget = 0;
 };
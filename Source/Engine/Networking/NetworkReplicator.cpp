@@ -16,6 +16,7 @@
 #include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Core/Collections/ChunkedArray.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Types/DataContainer.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Engine/EngineService.h"
@@ -29,6 +30,7 @@
 #include "Engine/Scripting/ScriptingObjectReference.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/ThreadLocal.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "FlaxEngine.Gen.h"
 #endif
@@ -43,22 +45,62 @@ bool NetworkReplicator::EnableLog = false;
 #define NETWORK_REPLICATOR_LOG(messageType, format, ...)
 #endif
 
+bool NetworkReplicator::EnableParallelSerialization = true;
+
 #if COMPILE_WITH_PROFILER
 bool NetworkInternal::EnableProfiling = false;
 Dictionary<Pair<ScriptingTypeHandle, StringAnsiView>, NetworkInternal::ProfilerEvent> NetworkInternal::ProfilerEvents;
 #endif
 
+// Amount of network frames after which messages that use undeclared ids are dropped
+#define NETWORK_DEFERRED_MESSAGE_FRAMES 120
+
+// Amount of recent object states kept by sender and receiver to be used as a baseline for delta-compressed replication
+#define NETWORK_REPLICATION_BASELINES 8
+
+// Minimum amount of replicated objects per job when serializing objects on Job System threads (and amount of objects taken by the job at once)
+#define NETWORK_REPLICATION_JOB_OBJECTS 256
+#define NETWORK_REPLICATION_JOB_BATCH 32
+
+// Objects, types and RPCs are referenced in messages by the compact ids assigned by the sender for the session duration (declared in NetworkMessageObjectIds before use)
+PACK_STRUCT(struct NetworkMessageObjectIds
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectIds;
+    uint16 RecordsCount = 0; // Amount of NetworkIdsRecordType-prefixed records that follow
+    });
+
+enum class NetworkIdsRecordType : uint8
+{
+    // uint16 TypeId, uint16 NameLength, char Name[NameLength]
+    Type,
+    // uint16 RpcId, uint16 TypeId, uint16 NameLength, char Name[NameLength]
+    Rpc,
+    // uint32 ObjectId, Guid ObjectId, Guid ParentId, uint16 TypeId
+    Object,
+};
+
 PACK_STRUCT(struct NetworkMessageObjectReplicate
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicate;
     uint32 OwnerFrame;
-    Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
-    Guid ParentId;
-    char ObjectTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
+    uint32 ObjectId;
+    uint16 BaselineOffset; // If non-zero then data is a delta against the object state from frame OwnerFrame - BaselineOffset (see WriteReplicationDelta)
     uint16 DataSize;
     uint16 PartsCount;
     });
 
+PACK_STRUCT(struct NetworkMessageObjectReplicateAck
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicateAck;
+    uint16 ItemsCount;
+    });
+
+PACK_STRUCT(struct NetworkMessageObjectReplicateAckItem
+    {
+    uint32 ObjectId;
+    uint32 OwnerFrame;
+    });
+
 PACK_STRUCT(struct NetworkMessageObjectReplicatePart
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicatePart;
@@ -67,7 +109,7 @@ PACK_STRUCT(struct NetworkMessageObjectReplicatePart
     uint16 PartsCount;
     uint16 PartStart;
     uint16 PartSize;
-    Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
+    uint32 ObjectId;
     });
 
 PACK_STRUCT(struct NetworkMessageObjectSpawn
@@ -89,36 +131,50 @@ PACK_STRUCT(struct NetworkMessageObjectSpawnPart
 
 PACK_STRUCT(struct NetworkMessageObjectSpawnItem
     {
-    Guid ObjectId;
-    Guid ParentId;
+    uint32 ObjectId;
     Guid PrefabObjectID;
-    char ObjectTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
     });
 
 PACK_STRUCT(struct NetworkMessageObjectDespawn
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectDespawn;
-    Guid ObjectId;
+    uint32 ObjectId;
     });
 
 PACK_STRUCT(struct NetworkMessageObjectRole
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectRole;
-    Guid ObjectId;
+    uint32 ObjectId;
     uint32 OwnerClientId;
     });
 
 PACK_STRUCT(struct NetworkMessageObjectRpc
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectRpc;
-    Guid ObjectId;
-    Guid ParentId;
-    char ObjectTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
-    char RpcTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
-    char RpcName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
+    uint32 ObjectId;
+    uint16 RpcId;
     uint16 ArgsSize;
     });
 
+struct ReplicationSnapshot
+{
+    uint32 SenderClientId;
+    uint32 Frame;
+    Array<byte> Data;
+};
+
+struct ReplicationBaseline
+{
+    uint32 ClientId;
+    uint32 Frame;
+};
+
+struct ReplicationPriority
+{
+    uint32 ClientId;
+    float Value;
+};
+
 struct NetworkReplicatedObject
 {
     ScriptingObjectReference<ScriptingObject> Object;
@@ -131,6 +187,11 @@ struct NetworkReplicatedObject
     uint8 Synced : 1;
     DataContainer<uint32> TargetClientIds;
     INetworkObject* AsNetworkObject;
+    Array<ReplicationSnapshot> SentSnapshots; // Recently sent states of the object
+    Array<ReplicationSnapshot> ReceivedSnapshots; // Recently received states of the object
+    Array<ReplicationBaseline, InlinedAllocation<4>> Baselines; // The latest states acknowledged by the receivers
+    Array<ReplicationPriority, InlinedAllocation<4>> Priorities; // The priority accumulated by the receivers when updates got delayed by the bandwidth budget
+    NetworkClientsMask DelayedClients; // The clients that didn't receive the latest update due to the bandwidth budget
 
     NetworkReplicatedObject()
     {
@@ -157,6 +218,17 @@ struct NetworkReplicatedObject
     {
         return ObjectId.ToString();
     }
+
+    // Gets the states history for the sender (separate for sent and received states so they never evict each other, eg. on server relaying object owned by client)
+    FORCE_INLINE Array<ReplicationSnapshot>& GetSnapshots(uint32 senderClientId)
+    {
+        return senderClientId == NetworkManager::LocalClientId ? SentSnapshots : ReceivedSnapshots;
+    }
+
+    FORCE_INLINE const Array<ReplicationSnapshot>& GetSnapshots(uint32 senderClientId) const
+    {
+        return senderClientId == NetworkManager::LocalClientId ? SentSnapshots : ReceivedSnapshots;
+    }
 };
 
 inline uint32 GetHash(const NetworkReplicatedObject& key)
@@ -173,7 +245,8 @@ struct Serializer
 struct ReplicateItem
 {
     ScriptingObjectReference<ScriptingObject> Object;
-    Guid ObjectId;
+    uint32 ObjectId;
+    uint16 BaselineOffset;
     uint16 PartsLeft;
     uint32 OwnerFrame;
     uint32 OwnerClientId;
@@ -193,9 +266,18 @@ struct SpawnItem
 struct SpawnItemParts
 {
     NetworkMessageObjectSpawn MsgData;
+    uint32 SenderClientId;
     Array<NetworkMessageObjectSpawnItem> Items;
 };
 
+struct ObjectSpawnItem
+{
+    Guid ObjectId;
+    Guid ParentId;
+    Guid PrefabObjectID;
+    ScriptingTypeHandle ObjectType;
+};
+
 struct SpawnGroup
 {
     Array<SpawnItem*, InlinedAllocation<8>> Items;
@@ -204,6 +286,7 @@ struct SpawnGroup
 struct DespawnItem
 {
     Guid Id;
+    uint32 NetworkId;
     DataContainer<uint32> Targets;
 };
 
@@ -216,6 +299,104 @@ struct RpcItem
     DataContainer<uint32> Targets;
 };
 
+struct NetworkObjectId
+{
+    uint32 Id;
+    Guid ObjectId;
+    Guid ParentId;
+    uint16 TypeId;
+};
+
+struct NetworkIdsSendTable
+{
+    uint32 NextObjectId = 1;
+    uint16 NextTypeId = 1;
+    uint16 NextRpcId = 1;
+    Dictionary<Guid, NetworkObjectId> Objects; // Key is local object id
+    Dictionary<uint32, Guid> ObjectsById;
+    Dictionary<ScriptingTypeHandle, uint16> Types;
+    Dictionary<NetworkRpcName, uint16> Rpcs;
+
+    // Ids assigned since the last declaration message
+    Array<NetworkObjectId> PendingObjects;
+    Array<Pair<uint16, ScriptingTypeHandle>> PendingTypes;
+    Array<Pair<uint16, NetworkRpcName>> PendingRpcs;
+};
+
+struct NetworkReceivedObjectId
+{
+    Guid ObjectId;
+    Guid ParentId;
+    ScriptingTypeHandle ObjectType;
+};
+
+struct NetworkIdsReceiveTable
+{
+    Dictionary<uint32, NetworkReceivedObjectId> Objects;
+    Dictionary<uint16, ScriptingTypeHandle> Types;
+    Dictionary<uint16, NetworkRpcName> Rpcs;
+};
+
+struct ReplicationAck
+{
+    uint32 SenderClientId;
+    uint32 ObjectId;
+    uint32 OwnerFrame;
+
+    bool operator<(const ReplicationAck& other) const
+    {
+        return SenderClientId < other.SenderClientId;
+    }
+};
+
+struct ReplicationTargetsGroup
+{
+    const ReplicationSnapshot* Baseline;
+    Array<NetworkConnection> Targets;
+};
+
+struct ReplicationSerializeItem
+{
+    NetworkReplicatedObject* Item;
+    ScriptingObject* Object;
+    NetworkClientsMask TargetClients;
+    float Priority;
+    float CullDistance;
+    Serializer ObjectSerializer;
+    int32 StreamIndex;
+    uint32 Start;
+    uint32 Size;
+};
+
+struct ReplicationDelayedItem
+{
+    Guid ObjectId;
+    float Priority;
+    float CullDistance;
+};
+
+struct ReplicationScheduleItem
+{
+    int32 Index;
+    uint32 Size;
+    float Priority;
+    float* Accumulated;
+
+    bool operator<(const ReplicationScheduleItem& other) const
+    {
+        // Sort from the highest priority
+        return Priority > other.Priority;
+    }
+};
+
+struct DeferredMessage
+{
+    NetworkClient* Client;
+    uint32 SenderClientId;
+    uint32 Frame;
+    Array<byte> Data;
+};
+
 namespace
 {
     CriticalSection ObjectsLock;
@@ -232,12 +413,26 @@ namespace
     NetworkReplicationHierarchy* Hierarchy = nullptr;
     Array<NetworkClient*> NewClients;
     Array<NetworkConnection> CachedTargets;
+    Array<NetworkClient*> CachedTargetClients;
     Dictionary<ScriptingTypeHandle, Serializer> SerializersTable;
+    // Serializers are searched (and lazily added) also from the serialization jobs (eg. generated code serializing base types or fields)
+    CriticalSection SerializersLocker;
 #if !COMPILE_WITHOUT_CSHARP
     Dictionary<StringAnsiView, StringAnsi*> CSharpCachedNames;
 #endif
     Array<Guid> DespawnedObjects;
     uint32 SpawnId = 0;
+    NetworkIdsSendTable SendIds;
+    Dictionary<uint32, NetworkIdsReceiveTable*> ReceivedIds; // Key is sender client id (each peer assigns own ids)
+    Array<DeferredMessage> DeferredMessages; // Messages that use ids not yet declared by the sender
+    uint32 DeferredMessageFrame = 0;
+    Array<ReplicationAck> PendingAcks;
+    Array<byte> CachedDeltaBuffer;
+    Array<ReplicationTargetsGroup> CachedReplicationGroups;
+    Array<ReplicationSerializeItem> CachedSerializeItems;
+    Array<NetworkStream*> CachedSerializeStreams; // Per-job streams used for objects serialization
+    Array<ReplicationScheduleItem> CachedScheduleItems;
+    Array<ReplicationDelayedItem> DelayedObjects; // Objects that will be sent in the next update to the clients skipped due to the bandwidth budget
 
 #if USE_EDITOR
     void OnScriptsReloading()
@@ -253,16 +448,45 @@ namespace
 
         // Clear any references to non-engine scripts before code hot-reload
         BinaryModule* flaxModule = GetBinaryModuleFlaxEngine();
+        SerializersLocker.Lock();
         for (auto i = SerializersTable.Begin(); i.IsNotEnd(); ++i)
         {
             if (i->Key.Module != flaxModule)
                 SerializersTable.Remove(i);
         }
+        SerializersLocker.Unlock();
         for (auto i = NetworkRpcInfo::RPCsTable.Begin(); i.IsNotEnd(); ++i)
         {
             if (i->Key.First.Module != flaxModule)
                 NetworkRpcInfo::RPCsTable.Remove(i);
         }
+
+        // Non-engine types and RPCs will be declared again with new ids
+        for (auto i = SendIds.Types.Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Key.Module != flaxModule)
+                SendIds.Types.Remove(i);
+        }
+        for (auto i = SendIds.Rpcs.Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Key.First.Module != flaxModule)
+                SendIds.Rpcs.Remove(i);
+        }
+        SendIds.PendingTypes.Clear();
+        SendIds.PendingRpcs.Clear();
+        for (auto& e : ReceivedIds)
+        {
+            for (auto i = e.Value->Types.Begin(); i.IsNotEnd(); ++i)
+            {
+                if (i->Value.Module != flaxModule)
+                    e.Value->Types.Remove(i);
+            }
+            for (auto i = e.Value->Rpcs.Begin(); i.IsNotEnd(); ++i)
+            {
+                if (i->Value.First.Module != flaxModule)
+                    e.Value->Rpcs.Remove(i);
+            }
+        }
     }
 #endif
 }
@@ -323,6 +547,44 @@ void INetworkSerializable_Script_Deserialize(void* instance, NetworkStream* stre
     interface->Deserialize(stream);
 }
 
+bool FindSerializer(ScriptingTypeHandle typeHandle, Serializer& serializer)
+{
+    ScopeLock lock(SerializersLocker);
+    while (typeHandle)
+    {
+        if (SerializersTable.TryGet(typeHandle, serializer))
+            return true;
+
+        // Fallback to INetworkSerializable interface (if type implements it)
+        const ScriptingType& type = typeHandle.GetType();
+        const ScriptingType::InterfaceImplementation* interface = type.GetInterface(INetworkSerializable::TypeInitializer);
+        if (interface)
+        {
+            if (interface->IsNative)
+            {
+                // Native interface (implemented in C++)
+                serializer.Methods[0] = INetworkSerializable_Native_Serialize;
+                serializer.Methods[1] = INetworkSerializable_Native_Deserialize;
+                serializer.Tags[0] = serializer.Tags[1] = (void*)(intptr)interface->VTableOffset; // Pass VTableOffset to the callback
+            }
+            else
+            {
+                // Generic interface (implemented in C# or elsewhere)
+                ASSERT(type.Type == ScriptingTypes::Script);
+                serializer.Methods[0] = INetworkSerializable_Script_Serialize;
+                serializer.Methods[1] = INetworkSerializable_Script_Deserialize;
+                serializer.Tags[0] = serializer.Tags[1] = nullptr;
+            }
+            SerializersTable.Add(typeHandle, serializer);
+            return true;
+        }
+
+        // Fallback to base type
+        typeHandle = type.GetBaseType();
+    }
+    return false;
+}
+
 NetworkReplicatedObject* ResolveObject(Guid objectId)
 {
     auto it = Objects.Find(objectId);
@@ -333,7 +595,7 @@ NetworkReplicatedObject* ResolveObject(Guid objectId)
     return it != Objects.End() ? &it->Item : nullptr;
 }
 
-NetworkReplicatedObject* ResolveObject(Guid objectId, Guid parentId, const char objectTypeName[128])
+NetworkReplicatedObject* ResolveObject(Guid objectId, Guid parentId, const ScriptingTypeHandle& objectType)
 {
     // Lookup object
     NetworkReplicatedObject* obj = ResolveObject(objectId);
@@ -342,7 +604,6 @@ NetworkReplicatedObject* ResolveObject(Guid objectId, Guid parentId, const char
 
     // Try to find the object within the same parent (eg. spawned locally on both client and server)
     IdsRemappingTable.TryGet(parentId, parentId);
-    const ScriptingTypeHandle objectType = Scripting::FindScriptingType(StringAnsiView(objectTypeName));
     if (!objectType)
         return nullptr;
     for (auto& e : Objects)
@@ -392,11 +653,12 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const NetworkClien
 void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContainer<uint32>& clientIds, const uint32 excludedClientId = NetworkManager::ServerClientId, const NetworkClientsMask clientsMask = NetworkClientsMask::All)
 {
     CachedTargets.Clear();
+    CachedTargetClients.Clear();
     if (clientIds.IsValid())
     {
         for (int32 clientIndex = 0; clientIndex < clients.Count(); clientIndex++)
         {
-            const NetworkClient* client = clients.Get()[clientIndex];
+            NetworkClient* client = clients.Get()[clientIndex];
             if (client->State == NetworkConnectionState::Connected && client->ClientId != excludedClientId && clientsMask.HasBit(clientIndex))
             {
                 for (int32 i = 0; i < clientIds.Length(); i++)
@@ -404,6 +666,7 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContaine
                     if (clientIds[i] == client->ClientId)
                     {
                         CachedTargets.Add(client->Connection);
+                        CachedTargetClients.Add(client);
                         break;
                     }
                 }
@@ -414,9 +677,12 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContaine
     {
         for (int32 clientIndex = 0; clientIndex < clients.Count(); clientIndex++)
         {
-            const NetworkClient* client = clients.Get()[clientIndex];
+            NetworkClient* client = clients.Get()[clientIndex];
             if (client->State == NetworkConnectionState::Connected && client->ClientId != excludedClientId && clientsMask.HasBit(clientIndex))
+            {
                 CachedTargets.Add(client->Connection);
+                CachedTargetClients.Add(client);
+            }
         }
     }
 }
@@ -467,10 +733,337 @@ FORCE_INLINE void BuildCachedTargets(const NetworkReplicatedObject& item, const
     BuildCachedTargets(NetworkManager::Clients, item.TargetClientIds, item.OwnerClientId, clientsMask);
 }
 
-FORCE_INLINE void GetNetworkName(char buffer[128], const StringAnsiView& name)
+bool IsReplicationTarget(const NetworkReplicatedObject& item, const NetworkClient* client)
+{
+    // Matches BuildCachedTargets for the object
+    if (client->State != NetworkConnectionState::Connected || client->ClientId == item.OwnerClientId)
+        return false;
+    if (item.TargetClientIds.IsValid())
+    {
+        for (int32 i = 0; i < item.TargetClientIds.Length(); i++)
+        {
+            if (item.TargetClientIds[i] == client->ClientId)
+                return true;
+        }
+        return false;
+    }
+    return true;
+}
+
+float& GetReplicationPriority(NetworkReplicatedObject& item, uint32 clientId)
+{
+    for (ReplicationPriority& e : item.Priorities)
+    {
+        if (e.ClientId == clientId)
+            return e.Value;
+    }
+    auto& e = item.Priorities.AddOne();
+    e.ClientId = clientId;
+    e.Value = 0.0f;
+    return e.Value;
+}
+
+uint16 GetNetworkTypeId(const ScriptingTypeHandle& type)
+{
+    if (!type)
+        return 0;
+    const uint16* id = SendIds.Types.TryGet(type);
+    if (id)
+        return *id;
+    const uint16 newId = SendIds.NextTypeId++;
+    ASSERT(newId != 0);
+    SendIds.Types.Add(type, newId);
+    SendIds.PendingTypes.Add(Pair<uint16, ScriptingTypeHandle>(newId, type));
+    return newId;
+}
+
+uint16 GetNetworkRpcId(const NetworkRpcName& name)
+{
+    const uint16* id = SendIds.Rpcs.TryGet(name);
+    if (id)
+        return *id;
+
+    // Use name from the RPCs table to be sure that text stays alive
+    NetworkRpcName key = name;
+    const auto it = NetworkRpcInfo::RPCsTable.Find(name);
+    if (it.IsNotEnd())
+        key = it->Key;
+    GetNetworkTypeId(key.First);
+    const uint16 newId = SendIds.NextRpcId++;
+    ASSERT(newId != 0);
+    SendIds.Rpcs.Add(key, newId);
+    SendIds.PendingRpcs.Add(Pair<uint16, NetworkRpcName>(newId, key));
+    return newId;
+}
+
+uint32 GetNetworkObjectId(const NetworkReplicatedObject& item)
+{
+    Guid objectId = item.ObjectId;
+    Guid parentId = item.ParentId;
+    if (NetworkManager::IsClient())
+    {
+        // Remap local client object ids into server ids
+        IdsRemappingTable.KeyOf(objectId, &objectId);
+        IdsRemappingTable.KeyOf(parentId, &parentId);
+    }
+    const ScriptingObject* obj = item.Object.Get();
+    uint16 typeId = obj ? GetNetworkTypeId(obj->GetTypeHandle()) : 0;
+    NetworkObjectId* e = SendIds.Objects.TryGet(item.ObjectId);
+    if (e && e->ObjectId == objectId && e->ParentId == parentId && (e->TypeId == typeId || typeId == 0))
+        return e->Id;
+    if (!e)
+    {
+        e = &SendIds.Objects[item.ObjectId];
+        e->Id = SendIds.NextObjectId++;
+        SendIds.ObjectsById.Add(e->Id, item.ObjectId);
+    }
+    else if (typeId == 0)
+    {
+        // Keep the last known type of the deleted object
+        typeId = e->TypeId;
+    }
+
+    // Declare a new object or update the existing declaration (eg. client object got remapped into server object)
+    e->ObjectId = objectId;
+    e->ParentId = parentId;
+    e->TypeId = typeId;
+    SendIds.PendingObjects.Add(*e);
+    return e->Id;
+}
+
+void ReleaseNetworkObjectId(const Guid& objectId)
+{
+    const NetworkObjectId* e = SendIds.Objects.TryGet(objectId);
+    if (e)
+    {
+        SendIds.ObjectsById.Remove(e->Id);
+        SendIds.Objects.Remove(objectId);
+    }
+}
+
+class NetworkIdsMessageWriter
+{
+private:
+    NetworkPeer* _peer;
+    const Array<NetworkConnection>* _targets;
+    NetworkMessage _msg;
+    uint16 _count = 0;
+
+public:
+    NetworkIdsMessageWriter(const Array<NetworkConnection>* targets)
+        : _peer(NetworkManager::Peer)
+        , _targets(targets)
+    {
+    }
+
+    ~NetworkIdsMessageWriter()
+    {
+        Send();
+    }
+
+    void WriteType(uint16 id, const ScriptingTypeHandle& type)
+    {
+        const StringAnsiView& name = type.GetType().Fullname;
+        Reserve(sizeof(NetworkIdsRecordType) + sizeof(uint16) * 2 + name.Length());
+        _msg.WriteUInt8((uint8)NetworkIdsRecordType::Type);
+        _msg.WriteUInt16(id);
+        _msg.WriteUInt16((uint16)name.Length());
+        _msg.WriteBytes((uint8*)name.Get(), name.Length());
+    }
+
+    void WriteRpc(uint16 id, const NetworkRpcName& name)
+    {
+        const uint16* typeId = SendIds.Types.TryGet(name.First);
+        Reserve(sizeof(NetworkIdsRecordType) + sizeof(uint16) * 3 + name.Second.Length());
+        _msg.WriteUInt8((uint8)NetworkIdsRecordType::Rpc);
+        _msg.WriteUInt16(id);
+        _msg.WriteUInt16(typeId ? *typeId : 0);
+        _msg.WriteUInt16((uint16)name.Second.Length());
+        _msg.WriteBytes((uint8*)name.Second.Get(), name.Second.Length());
+    }
+
+    void WriteObject(const NetworkObjectId& e)
+    {
+        Reserve(sizeof(NetworkIdsRecordType) + sizeof(uint32) + sizeof(Guid) * 2 + sizeof(uint16));
+        _msg.WriteUInt8((uint8)NetworkIdsRecordType::Object);
+        _msg.WriteUInt32(e.Id);
+        _msg.WriteGuid(e.ObjectId);
+        _msg.WriteGuid(e.ParentId);
+        _msg.WriteUInt16(e.TypeId);
+    }
+
+private:
+    void Reserve(uint32 size)
+    {
+        if (!_msg.IsValid() || _msg.Position + size > _msg.BufferSize || _count == MAX_uint16)
+        {
+            Send();
+            _msg = _peer->BeginSendMessage();
+            _msg.WriteStructure(NetworkMessageObjectIds());
+            _count = 0;
+        }
+        _count++;
+    }
+
+    void Send()
+    {
+        if (!_msg.IsValid())
+            return;
+        ((NetworkMessageObjectIds*)_msg.Buffer)->RecordsCount = _count;
+        if (_targets)
+            _peer->EndSendMessage(NetworkChannelType::ReliableOrdered, _msg, *_targets);
+        else
+            _peer->EndSendMessage(NetworkChannelType::ReliableOrdered, _msg);
+        _msg = NetworkMessage();
+    }
+};
+
+void SendNetworkIds()
+{
+    // Declare newly assigned ids before sending any messages that use them
+    if (SendIds.PendingObjects.IsEmpty() && SendIds.PendingTypes.IsEmpty() && SendIds.PendingRpcs.IsEmpty())
+        return;
+    PROFILE_CPU();
+    Array<NetworkConnection> targets;
+    const bool isClient = NetworkManager::IsClient();
+    if (!isClient)
+    {
+        for (const NetworkClient* client : NetworkManager::Clients)
+        {
+            if (client->State == NetworkConnectionState::Connected)
+                targets.Add(client->Connection);
+        }
+    }
+    if (isClient || targets.HasItems())
+    {
+        NetworkIdsMessageWriter writer(isClient ? nullptr : &targets);
+        for (const auto& e : SendIds.PendingTypes)
+            writer.WriteType(e.First, e.Second);
+        for (const auto& e : SendIds.PendingRpcs)
+            writer.WriteRpc(e.First, e.Second);
+        for (const auto& e : SendIds.PendingObjects)
+            writer.WriteObject(e);
+    }
+    SendIds.PendingTypes.Clear();
+    SendIds.PendingRpcs.Clear();
+    SendIds.PendingObjects.Clear();
+}
+
+void SendNetworkIdsTable(const Array<NetworkClient*>& clients)
+{
+    // Declare all ids assigned so far to the late-joining clients
+    PROFILE_CPU();
+    Array<NetworkConnection> targets;
+    for (const NetworkClient* client : clients)
+    {
+        if (client->State == NetworkConnectionState::Connected)
+            targets.Add(client->Connection);
+    }
+    if (targets.IsEmpty())
+        return;
+    NetworkIdsMessageWriter writer(&targets);
+    for (const auto& e : SendIds.Types)
+        writer.WriteType(e.Value, e.Key);
+    for (const auto& e : SendIds.Rpcs)
+        writer.WriteRpc(e.Value, e.Key);
+    for (const auto& e : SendIds.Objects)
+        writer.WriteObject(e.Value);
+}
+
+NetworkIdsReceiveTable* GetReceivedIds(const NetworkClient* client)
+{
+    NetworkIdsReceiveTable* result = nullptr;
+    ReceivedIds.TryGet(client ? client->ClientId : NetworkManager::ServerClientId, result);
+    return result;
+}
+
+FORCE_INLINE const NetworkReceivedObjectId* ResolveNetworkObjectId(const NetworkClient* client, uint32 id)
+{
+    const NetworkIdsReceiveTable* ids = GetReceivedIds(client);
+    return ids ? ids->Objects.TryGet(id) : nullptr;
+}
+
+void DeferMessage(const NetworkEvent& event, NetworkClient* client)
+{
+    // Wait for the sender to declare ids used by this message (declarations are reliable but can arrive after messages from other channels)
+    auto& e = DeferredMessages.AddOne();
+    e.Client = client;
+    e.SenderClientId = client ? client->ClientId : NetworkManager::ServerClientId;
+    e.Frame = DeferredMessageFrame != 0 ? DeferredMessageFrame : NetworkManager::Frame;
+    e.Data.Set(event.Message.Buffer, event.Message.Length);
+}
+
+void InvokeDeferredMessages(uint32 senderClientId)
+{
+    if (DeferredMessages.IsEmpty())
+        return;
+    PROFILE_CPU();
+    Array<DeferredMessage> messages;
+    for (int32 i = 0; i < DeferredMessages.Count(); i++)
+    {
+        if (DeferredMessages[i].SenderClientId == senderClientId)
+        {
+            messages.Add(MoveTemp(DeferredMessages[i]));
+            DeferredMessages.RemoveAtKeepOrder(i--);
+        }
+    }
+    NetworkPeer* peer = NetworkManager::Peer;
+    for (auto& e : messages)
+    {
+        NetworkEvent event;
+        event.EventType = NetworkEventType::Message;
+        event.Message = NetworkMessage(e.Data.Get(), 0, e.Data.Count(), e.Data.Count(), 0);
+        if (e.Client)
+            event.Sender = e.Client->Connection;
+        DeferredMessageFrame = e.Frame;
+        switch ((NetworkMessageIDs)e.Data[0])
+        {
+        case NetworkMessageIDs::ObjectReplicate:
+            NetworkInternal::OnNetworkMessageObjectReplicate(event, e.Client, peer);
+            break;
+        case NetworkMessageIDs::ObjectReplicatePart:
+            NetworkInternal::OnNetworkMessageObjectReplicatePart(event, e.Client, peer);
+            break;
+        case NetworkMessageIDs::ObjectSpawn:
+            NetworkInternal::OnNetworkMessageObjectSpawn(event, e.Client, peer);
+            break;
+        case NetworkMessageIDs::ObjectSpawnPart:
+            NetworkInternal::OnNetworkMessageObjectSpawnPart(event, e.Client, peer);
+            break;
+        case NetworkMessageIDs::ObjectDespawn:
+            NetworkInternal::OnNetworkMessageObjectDespawn(event, e.Client, peer);
+            break;
+        case NetworkMessageIDs::ObjectRole:
+            NetworkInternal::OnNetworkMessageObjectRole(event, e.Client, peer);
+            break;
+        case NetworkMessageIDs::ObjectRpc:
+            NetworkInternal::OnNetworkMessageObjectRpc(event, e.Client, peer);
+            break;
+        default:
+            break;
+        }
+        DeferredMessageFrame = 0;
+    }
+}
+
+bool ResolveSpawnItems(const NetworkClient* client, const NetworkMessageObjectSpawnItem* msgDataItems, int32 count, Array<ObjectSpawnItem>& result)
 {
-    Platform::MemoryCopy(buffer, name.Get(), name.Length());
-    buffer[name.Length()] = 0;
+    const NetworkIdsReceiveTable* ids = GetReceivedIds(client);
+    if (!ids)
+        return true;
+    result.Resize(count);
+    for (int32 i = 0; i < count; i++)
+    {
+        const NetworkReceivedObjectId* id = ids->Objects.TryGet(msgDataItems[i].ObjectId);
+        if (!id)
+            return true;
+        auto& item = result[i];
+        item.ObjectId = id->ObjectId;
+        item.ParentId = id->ParentId;
+        item.PrefabObjectID = msgDataItems[i].PrefabObjectID;
+        item.ObjectType = id->ObjectType;
+    }
+    return false;
 }
 
 void SetupObjectSpawnMessageItem(SpawnItem* e, NetworkMessage& msg)
@@ -481,19 +1074,11 @@ void SetupObjectSpawnMessageItem(SpawnItem* e, NetworkMessage& msg)
 
     // Add object into spawn message
     NetworkMessageObjectSpawnItem msgDataItem;
-    msgDataItem.ObjectId = item.ObjectId;
-    msgDataItem.ParentId = item.ParentId;
-    if (NetworkManager::IsClient())
-    {
-        // Remap local client object ids into server ids
-        IdsRemappingTable.KeyOf(msgDataItem.ObjectId, &msgDataItem.ObjectId);
-        IdsRemappingTable.KeyOf(msgDataItem.ParentId, &msgDataItem.ParentId);
-    }
+    msgDataItem.ObjectId = GetNetworkObjectId(item);
     msgDataItem.PrefabObjectID = Guid::Empty;
     auto* objScene = ScriptingObject::Cast<SceneObject>(obj);
     if (objScene && objScene->HasPrefabLink())
         msgDataItem.PrefabObjectID = objScene->GetPrefabObjectID();
-    GetNetworkName(msgDataItem.ObjectTypeName, obj->GetType().Fullname);
     msg.WriteStructure(msgDataItem);
 }
 
@@ -502,6 +1087,9 @@ void SendObjectSpawnMessage(const SpawnGroup& group, const Array<NetworkClient*>
     PROFILE_CPU();
     const bool isClient = NetworkManager::IsClient();
     auto* peer = NetworkManager::Peer;
+    for (SpawnItem* e : group.Items)
+        GetNetworkObjectId(Objects.Find(e->Object->GetID())->Item);
+    SendNetworkIds();
     NetworkMessage msg = peer->BeginSendMessage();
     NetworkMessageObjectSpawn msgData;
     msgData.ItemsCount = group.Items.Count();
@@ -570,8 +1158,9 @@ void SendObjectSpawnMessage(const SpawnGroup& group, const Array<NetworkClient*>
 void SendObjectRoleMessage(const NetworkReplicatedObject& item, const NetworkClient* excludedClient = nullptr)
 {
     NetworkMessageObjectRole msgData;
-    msgData.ObjectId = item.ObjectId;
+    msgData.ObjectId = GetNetworkObjectId(item);
     msgData.OwnerClientId = item.OwnerClientId;
+    SendNetworkIds();
     auto peer = NetworkManager::Peer;
     NetworkMessage msg = peer->BeginSendMessage();
     msg.WriteStructure(msgData);
@@ -592,6 +1181,7 @@ void DeleteNetworkObject(ScriptingObject* obj)
     const Guid id = obj->GetID();
     IdsRemappingTable.Remove(id);
     IdsRemappingTable.RemoveValue(id);
+    ReleaseNetworkObjectId(id);
 
     if (obj->Is<Script>() && ((Script*)obj)->GetParent())
         ((Script*)obj)->GetParent()->DeleteObject();
@@ -702,7 +1292,7 @@ ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& ms
     ReplicateItem* replicateItem = nullptr;
     for (auto& e : ReplicationParts)
     {
-        if (e.OwnerFrame == msgData.OwnerFrame && e.Data.Count() == msgData.DataSize && e.ObjectId == msgData.ObjectId)
+        if (e.OwnerFrame == msgData.OwnerFrame && e.Data.Count() == msgData.DataSize && e.ObjectId == msgData.ObjectId && e.OwnerClientId == senderClientId)
         {
             // Reuse
             replicateItem = &e;
@@ -714,23 +1304,254 @@ ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& ms
         // Add
         replicateItem = &ReplicationParts.AddOne();
         replicateItem->ObjectId = msgData.ObjectId;
+        replicateItem->BaselineOffset = 0;
         replicateItem->PartsLeft = msgData.PartsCount;
         replicateItem->OwnerFrame = msgData.OwnerFrame;
         replicateItem->OwnerClientId = senderClientId;
         replicateItem->Data.Resize(msgData.DataSize);
     }
 
-    // Copy part data
-    ASSERT(replicateItem->PartsLeft > 0);
-    replicateItem->PartsLeft--;
-    ASSERT(partStart + partSize <= replicateItem->Data.Count());
-    const void* partData = event.Message.SkipBytes(partSize);
-    Platform::MemoryCopy(replicateItem->Data.Get() + partStart, partData, partSize);
-
-    return replicateItem;
+    // Copy part data
+    ASSERT(replicateItem->PartsLeft > 0);
+    replicateItem->PartsLeft--;
+    ASSERT(partStart + partSize <= replicateItem->Data.Count());
+    const void* partData = event.Message.SkipBytes(partSize);
+    Platform::MemoryCopy(replicateItem->Data.Get() + partStart, partData, partSize);
+
+    return replicateItem;
+}
+
+uint32 WriteReplicationDelta(const byte* data, uint32 size, const byte* baseline, uint32 baselineSize, byte* output)
+{
+    // Layout: uint16 state size, bit mask of the changed bytes, XOR of the changed bytes with the baseline
+    const uint16 stateSize = (uint16)size;
+    Platform::MemoryCopy(output, &stateSize, sizeof(uint16));
+    byte* mask = output + sizeof(uint16);
+    byte* values = mask + (size + 7) / 8;
+    for (uint32 i = 0; i < size; i += 8)
+    {
+        const uint32 count = Math::Min<uint32>(size - i, 8);
+        byte bits = 0;
+        for (uint32 j = 0; j < count; j++)
+        {
+            const uint32 k = i + j;
+            const byte value = data[k] ^ (k < baselineSize ? baseline[k] : 0);
+            if (value)
+            {
+                bits |= 1 << j;
+                *values++ = value;
+            }
+        }
+        mask[i / 8] = bits;
+    }
+    return (uint32)(values - output);
+}
+
+uint32 GetReplicationSendSize(const byte* data, uint32 size, const ReplicationSnapshot* baseline)
+{
+    // Matches the size of the data sent by SendObjectReplicateMessage (delta is used only if it's smaller than the full state)
+    if (!baseline)
+        return size;
+    const byte* baselineData = baseline->Data.Get();
+    const uint32 baselineSize = baseline->Data.Count();
+    uint32 deltaSize = sizeof(uint16) + (size + 7) / 8;
+    for (uint32 i = 0; i < size && deltaSize < size; i++)
+        deltaSize += (data[i] ^ (i < baselineSize ? baselineData[i] : 0)) != 0;
+    return Math::Min(deltaSize, size);
+}
+
+bool ReadReplicationDelta(const byte* delta, uint32 deltaSize, const byte* baseline, uint32 baselineSize, Array<byte>& output)
+{
+    uint16 size;
+    if (deltaSize < sizeof(uint16))
+        return true;
+    Platform::MemoryCopy(&size, delta, sizeof(uint16));
+    const byte* mask = delta + sizeof(uint16);
+    const byte* values = mask + (size + 7) / 8;
+    const byte* end = delta + deltaSize;
+    if (values > end)
+        return true;
+    output.Resize(size, false);
+    byte* result = output.Get();
+    for (uint32 i = 0; i < size; i++)
+    {
+        byte value = i < baselineSize ? baseline[i] : 0;
+        if (mask[i / 8] & (1 << (i % 8)))
+        {
+            if (values == end)
+                return true;
+            value ^= *values++;
+        }
+        result[i] = value;
+    }
+    return false;
+}
+
+const ReplicationSnapshot* FindReplicationSnapshot(const NetworkReplicatedObject& item, uint32 senderClientId, uint32 frame)
+{
+    for (const ReplicationSnapshot& e : item.GetSnapshots(senderClientId))
+    {
+        if (e.Frame == frame && e.SenderClientId == senderClientId)
+            return &e;
+    }
+    return nullptr;
+}
+
+const ReplicationSnapshot* GetReplicationBaseline(const NetworkReplicatedObject& item, uint32 clientId)
+{
+    for (const ReplicationBaseline& e : item.Baselines)
+    {
+        if (e.ClientId == clientId)
+        {
+            if (NetworkManager::Frame - e.Frame > MAX_uint16)
+                return nullptr;
+            return FindReplicationSnapshot(item, NetworkManager::LocalClientId, e.Frame);
+        }
+    }
+    return nullptr;
+}
+
+void AddReplicationSnapshot(NetworkReplicatedObject& item, uint32 senderClientId, uint32 frame, const byte* data, uint32 dataSize)
+{
+    Array<ReplicationSnapshot>& snapshots = item.GetSnapshots(senderClientId);
+    ReplicationSnapshot* snapshot = nullptr;
+    if (snapshots.Count() < NETWORK_REPLICATION_BASELINES)
+    {
+        snapshot = &snapshots.AddOne();
+    }
+    else
+    {
+        // Reuse the oldest snapshot (or the one from the previous object owner)
+        for (ReplicationSnapshot& e : snapshots)
+        {
+            if (e.SenderClientId != senderClientId)
+            {
+                snapshot = &e;
+                break;
+            }
+            if (!snapshot || e.Frame < snapshot->Frame)
+                snapshot = &e;
+        }
+    }
+    snapshot->SenderClientId = senderClientId;
+    snapshot->Frame = frame;
+    snapshot->Data.Set(data, (int32)dataSize);
+}
+
+void SendObjectReplicateMessage(NetworkMessageObjectReplicate msgData, const byte* data, uint32 size, const ReplicationSnapshot* baseline, const Array<NetworkConnection>* targets, uint32& dataSize, uint32& messageSize)
+{
+    auto* peer = NetworkManager::Peer;
+
+    // Send delta against the baseline (if it's smaller than the full state)
+    msgData.BaselineOffset = 0;
+    if (baseline)
+    {
+        CachedDeltaBuffer.Resize(sizeof(uint16) + (size + 7) / 8 + size, false);
+        const uint32 deltaSize = WriteReplicationDelta(data, size, baseline->Data.Get(), baseline->Data.Count(), CachedDeltaBuffer.Get());
+        if (deltaSize < size)
+        {
+            msgData.BaselineOffset = (uint16)(msgData.OwnerFrame - baseline->Frame);
+            data = CachedDeltaBuffer.Get();
+            size = deltaSize;
+        }
+    }
+
+    msgData.DataSize = size;
+    const uint32 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
+    const uint32 partMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicatePart);
+    uint32 partsCount = 1;
+    uint32 dataStart = 0;
+    uint32 msgDataSize = size;
+    if (size > msgMaxData)
+    {
+        // Send msgMaxData within first message
+        msgDataSize = msgMaxData;
+        dataStart += msgMaxData;
+
+        // Send rest of the data in separate parts
+        partsCount += Math::DivideAndRoundUp(size - dataStart, partMaxData);
+    }
+    else
+        dataStart += size;
+    ASSERT(partsCount <= MAX_uint16); // Data size is uint16 and the smallest MessageSize allows over 16 bytes per part so it always fits
+    msgData.PartsCount = partsCount;
+    NetworkMessage msg = peer->BeginSendMessage();
+    msg.WriteStructure(msgData);
+    msg.WriteBytes((uint8*)data, msgDataSize);
+    dataSize += msgDataSize;
+    messageSize += msg.Length;
+    if (targets)
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg, *targets);
+    else
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+
+    // Send all other parts
+    for (uint32 partIndex = 1; partIndex < partsCount; partIndex++)
+    {
+        NetworkMessageObjectReplicatePart msgDataPart;
+        msgDataPart.OwnerFrame = msgData.OwnerFrame;
+        msgDataPart.ObjectId = msgData.ObjectId;
+        msgDataPart.DataSize = msgData.DataSize;
+        msgDataPart.PartsCount = msgData.PartsCount;
+        msgDataPart.PartStart = dataStart;
+        msgDataPart.PartSize = Math::Min(size - dataStart, partMaxData);
+        msg = peer->BeginSendMessage();
+        msg.WriteStructure(msgDataPart);
+        msg.WriteBytes((uint8*)data + msgDataPart.PartStart, msgDataPart.PartSize);
+        messageSize += msg.Length;
+        dataSize += msgDataPart.PartSize;
+        dataStart += msgDataPart.PartSize;
+        if (targets)
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg, *targets);
+        else
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+    }
+    ASSERT_LOW_LAYER(dataStart == size);
+}
+
+void SendReplicationAcks()
+{
+    PROFILE_CPU();
+    auto* peer = NetworkManager::Peer;
+    const bool isClient = NetworkManager::IsClient();
+    Sorting::QuickSort(PendingAcks);
+    for (int32 start = 0; start < PendingAcks.Count();)
+    {
+        // Send acknowledgements to the sender of the objects state
+        const uint32 senderClientId = PendingAcks[start].SenderClientId;
+        int32 end = start + 1;
+        while (end < PendingAcks.Count() && PendingAcks[end].SenderClientId == senderClientId)
+            end++;
+        const NetworkClient* client = isClient ? nullptr : NetworkManager::GetClient(senderClientId);
+        if (isClient || (client && client->State == NetworkConnectionState::Connected))
+        {
+            constexpr uint32 maxItems = MAX_uint16;
+            const uint32 msgMaxItems = Math::Min<uint32>((peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicateAck)) / sizeof(NetworkMessageObjectReplicateAckItem), maxItems);
+            for (int32 i = start; i < end;)
+            {
+                NetworkMessageObjectReplicateAck msgData;
+                msgData.ItemsCount = (uint16)Math::Min<uint32>(end - i, msgMaxItems);
+                NetworkMessage msg = peer->BeginSendMessage();
+                msg.WriteStructure(msgData);
+                for (int32 j = 0; j < msgData.ItemsCount; j++, i++)
+                {
+                    NetworkMessageObjectReplicateAckItem msgDataItem;
+                    msgDataItem.ObjectId = PendingAcks[i].ObjectId;
+                    msgDataItem.OwnerFrame = PendingAcks[i].OwnerFrame;
+                    msg.WriteStructure(msgDataItem);
+                }
+                if (isClient)
+                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+                else
+                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg, client->Connection);
+            }
+        }
+        start = end;
+    }
+    PendingAcks.Clear();
 }
 
-void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, byte* data, uint32 dataSize, uint32 senderClientId)
+void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, uint16 baselineOffset, byte* data, uint32 dataSize, uint32 senderClientId, uint32 objectNetworkId)
 {
     ScriptingObject* obj = item.Object.Get();
     if (!obj)
@@ -743,8 +1564,27 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
     // Drop object replication if it has old data (eg. newer message was already processed due to unordered channel usage)
     if (item.LastOwnerFrame >= ownerFrame)
         return;
+
+    // Reconstruct the object state from the delta
+    if (baselineOffset != 0)
+    {
+        const ReplicationSnapshot* baseline = FindReplicationSnapshot(item, senderClientId, ownerFrame - baselineOffset);
+        if (!baseline || ReadReplicationDelta(data, dataSize, baseline->Data.Get(), baseline->Data.Count(), CachedDeltaBuffer))
+        {
+            // Missing baseline so ask sender to send the full state
+            NETWORK_REPLICATOR_LOG(Warning, "[NetworkReplicator] Missing replication baseline for object {}", item.ToString());
+            PendingAcks.Add({ senderClientId, objectNetworkId, 0 });
+            return;
+        }
+        data = CachedDeltaBuffer.Get();
+        dataSize = CachedDeltaBuffer.Count();
+    }
     item.LastOwnerFrame = ownerFrame;
 
+    // Keep the state as a baseline for the future deltas and acknowledge it
+    AddReplicationSnapshot(item, senderClientId, ownerFrame, data, dataSize);
+    PendingAcks.Add({ senderClientId, objectNetworkId, ownerFrame });
+
     // Setup message reading stream
     if (CachedReadStream == nullptr)
         CachedReadStream = New<NetworkStream>();
@@ -775,20 +1615,20 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
         DirtyObjectImpl(item, obj);
 }
 
-void InvokeObjectSpawn(const NetworkMessageObjectSpawn& msgData, const NetworkMessageObjectSpawnItem* msgDataItems)
+void InvokeObjectSpawn(const NetworkMessageObjectSpawn& msgData, const ObjectSpawnItem* msgDataItems)
 {
     ScopeLock lock(ObjectsLock);
 
     // Check if that object has been already spawned
     auto& rootItem = msgDataItems[0];
-    NetworkReplicatedObject* root = ResolveObject(rootItem.ObjectId, rootItem.ParentId, rootItem.ObjectTypeName);
+    NetworkReplicatedObject* root = ResolveObject(rootItem.ObjectId, rootItem.ParentId, rootItem.ObjectType);
     if (root)
     {
         // Object already exists locally so just synchronize the ownership (and mark as spawned)
         for (int32 i = 0; i < msgData.ItemsCount; i++)
         {
             auto& msgDataItem = msgDataItems[i];
-            NetworkReplicatedObject* e = ResolveObject(msgDataItem.ObjectId, msgDataItem.ParentId, msgDataItem.ObjectTypeName);
+            NetworkReplicatedObject* e = ResolveObject(msgDataItem.ObjectId, msgDataItem.ParentId, msgDataItem.ObjectType);
             auto& item = *e;
             item.Spawned = true;
             if (NetworkManager::IsClient())
@@ -883,11 +1723,10 @@ void InvokeObjectSpawn(const NetworkMessageObjectSpawn& msgData, const NetworkMe
     else if (msgData.ItemsCount == 1)
     {
         // Spawn object
-        const ScriptingTypeHandle objectType = Scripting::FindScriptingType(rootItem.ObjectTypeName);
-        ScriptingObject* obj = ScriptingObject::NewObject(objectType);
+        ScriptingObject* obj = ScriptingObject::NewObject(rootItem.ObjectType);
         if (!obj)
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn object type {}", String(rootItem.ObjectTypeName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn object {} (unknown type)", rootItem.ObjectId);
             return;
         }
         objects.Add(obj);
@@ -899,11 +1738,10 @@ void InvokeObjectSpawn(const NetworkMessageObjectSpawn& msgData, const NetworkMe
         for (int32 i = 0; i < msgData.ItemsCount; i++)
         {
             auto& msgDataItem = msgDataItems[i];
-            const ScriptingTypeHandle objectType = Scripting::FindScriptingType(msgDataItem.ObjectTypeName);
-            ScriptingObject* obj = ScriptingObject::NewObject(objectType);
+            ScriptingObject* obj = ScriptingObject::NewObject(msgDataItem.ObjectType);
             if (!obj)
             {
-                NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn object type {}", String(msgDataItem.ObjectTypeName));
+                NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn object {} (unknown type)", msgDataItem.ObjectId);
                 for (ScriptingObject* e : objects)
                     Delete(e);
                 return;
@@ -1101,6 +1939,7 @@ void NetworkReplicator::AddSerializer(const ScriptingTypeHandle& typeHandle, Ser
     if (!typeHandle)
         return;
     const Serializer serializer{ { serialize, deserialize }, { serializeTag, deserializeTag } };
+    ScopeLock lock(SerializersLocker);
     SerializersTable[typeHandle] = serializer;
 }
 
@@ -1111,38 +1950,8 @@ bool NetworkReplicator::InvokeSerializer(const ScriptingTypeHandle& typeHandle,
 
     // Get serializers pair from table
     Serializer serializer;
-    if (!SerializersTable.TryGet(typeHandle, serializer))
-    {
-        // Fallback to INetworkSerializable interface (if type implements it)
-        const ScriptingType& type = typeHandle.GetType();
-        const ScriptingType::InterfaceImplementation* interface = type.GetInterface(INetworkSerializable::TypeInitializer);
-        if (interface)
-        {
-            if (interface->IsNative)
-            {
-                // Native interface (implemented in C++)
-                serializer.Methods[0] = INetworkSerializable_Native_Serialize;
-                serializer.Methods[1] = INetworkSerializable_Native_Deserialize;
-                serializer.Tags[0] = serializer.Tags[1] = (void*)(intptr)interface->VTableOffset; // Pass VTableOffset to the callback
-            }
-            else
-            {
-                // Generic interface (implemented in C# or elsewhere)
-                ASSERT(type.Type == ScriptingTypes::Script);
-                serializer.Methods[0] = INetworkSerializable_Script_Serialize;
-                serializer.Methods[1] = INetworkSerializable_Script_Deserialize;
-                serializer.Tags[0] = serializer.Tags[1] = nullptr;
-            }
-            SerializersTable.Add(typeHandle, serializer);
-        }
-        else if (const ScriptingTypeHandle baseTypeHandle = typeHandle.GetType().GetBaseType())
-        {
-            // Fallback to base type
-            return InvokeSerializer(baseTypeHandle, instance, stream, serialize);
-        }
-        else
-            return true;
-    }
+    if (!FindSerializer(typeHandle, serializer))
+        return true;
 
     // Invoke serializer
     const byte idx = serialize ? 0 : 1;
@@ -1210,6 +2019,7 @@ void NetworkReplicator::RemoveObject(ScriptingObject* obj)
     NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Remove object {}, owned by {}", obj->GetID().ToString(), it->Item.ParentId.ToString());
     if (Hierarchy && it->Item.Role == NetworkObjectRole::OwnedAuthoritative)
         Hierarchy->RemoveObject(obj);
+    ReleaseNetworkObjectId(it->Item.ObjectId);
     Objects.Remove(it);
 }
 
@@ -1262,6 +2072,7 @@ void NetworkReplicator::DespawnObject(ScriptingObject* obj)
     // Register for despawning (batched during update)
     auto& despawn = DespawnQueue.AddOne();
     despawn.Id = obj->GetID();
+    despawn.NetworkId = GetNetworkObjectId(item);
     despawn.Targets = item.TargetClientIds;
 
     // Prevent spawning
@@ -1519,6 +2330,38 @@ void NetworkInternal::NetworkReplicatorClientDisconnected(NetworkClient* client)
 {
     ScopeLock lock(ObjectsLock);
     NewClients.Remove(client);
+    NetworkIdsReceiveTable* ids;
+    if (ReceivedIds.TryGet(client->ClientId, ids))
+    {
+        Delete(ids);
+        ReceivedIds.Remove(client->ClientId);
+    }
+    for (int32 i = DeferredMessages.Count() - 1; i >= 0; i--)
+    {
+        if (DeferredMessages[i].Client == client)
+            DeferredMessages.RemoveAt(i);
+    }
+    for (auto& e : Objects)
+    {
+        auto& baselines = e.Item.Baselines;
+        for (int32 i = 0; i < baselines.Count(); i++)
+        {
+            if (baselines[i].ClientId == client->ClientId)
+            {
+                baselines.RemoveAt(i);
+                break;
+            }
+        }
+        auto& priorities = e.Item.Priorities;
+        for (int32 i = 0; i < priorities.Count(); i++)
+        {
+            if (priorities[i].ClientId == client->ClientId)
+            {
+                priorities.RemoveAt(i);
+                break;
+            }
+        }
+    }
 
     // Remove any objects owned by that client
     const uint32 clientId = client->ClientId;
@@ -1531,6 +2374,7 @@ void NetworkInternal::NetworkReplicatorClientDisconnected(NetworkClient* client)
             // Register for despawning (batched during update)
             auto& despawn = DespawnQueue.AddOne();
             despawn.Id = obj->GetID();
+            despawn.NetworkId = GetNetworkObjectId(item);
             despawn.Targets = MoveTemp(item.TargetClientIds);
 
             // Delete object locally
@@ -1570,11 +2414,31 @@ void NetworkInternal::NetworkReplicatorClear()
     SpawnQueue.Clear();
     DespawnQueue.Clear();
     IdsRemappingTable.Clear();
+    SendIds.NextObjectId = 1;
+    SendIds.NextTypeId = 1;
+    SendIds.NextRpcId = 1;
+    SendIds.Objects.Clear();
+    SendIds.ObjectsById.Clear();
+    SendIds.Types.Clear();
+    SendIds.Rpcs.Clear();
+    SendIds.PendingObjects.Clear();
+    SendIds.PendingTypes.Clear();
+    SendIds.PendingRpcs.Clear();
+    ReceivedIds.ClearDelete();
+    DeferredMessages.Clear();
+    PendingAcks.Clear();
+    CachedDeltaBuffer.Resize(0);
+    CachedReplicationGroups.Clear();
+    CachedSerializeItems.Clear();
+    CachedSerializeStreams.ClearDelete();
+    CachedScheduleItems.Clear();
+    DelayedObjects.Clear();
     SAFE_DELETE(CachedWriteStream);
     SAFE_DELETE(CachedReadStream);
     SAFE_DELETE(CachedReplicationResult);
     NewClients.Clear();
     CachedTargets.Clear();
+    CachedTargetClients.Clear();
     DespawnedObjects.Clear();
 }
 
@@ -1588,6 +2452,18 @@ void NetworkInternal::NetworkReplicatorUpdate()
 {
     PROFILE_CPU();
     ScopeLock lock(ObjectsLock);
+
+    // Drop messages that still wait for ids declaration after a long time (eg. sender released the object id)
+    for (int32 i = DeferredMessages.Count() - 1; i >= 0; i--)
+    {
+        if (NetworkManager::Frame - DeferredMessages[i].Frame > NETWORK_DEFERRED_MESSAGE_FRAMES)
+            DeferredMessages.RemoveAt(i);
+    }
+
+    // Acknowledge received objects states to let senders use them as a baseline for delta-compression
+    if (PendingAcks.HasItems())
+        SendReplicationAcks();
+
     if (Objects.Count() == 0)
         return;
     const bool isClient = NetworkManager::IsClient();
@@ -1619,6 +2495,10 @@ void NetworkInternal::NetworkReplicatorUpdate()
             SetupObjectSpawnGroupItem(obj, spawnGroups, spawnItem);
         }
 
+        // Declare all network ids used so far
+        SendNetworkIds();
+        SendNetworkIdsTable(NewClients);
+
         // Groups of objects to spawn
         for (SpawnGroup& g : spawnGroups)
         {
@@ -1631,17 +2511,13 @@ void NetworkInternal::NetworkReplicatorUpdate()
     if (DespawnQueue.Count() != 0)
     {
         PROFILE_CPU_NAMED("DespawnQueue");
+        SendNetworkIds();
         for (DespawnItem& e : DespawnQueue)
         {
             // Send despawn message
             NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Despawn object ID={}", e.Id.ToString());
             NetworkMessageObjectDespawn msgData;
-            msgData.ObjectId = e.Id;
-            if (isClient)
-            {
-                // Remap local client object ids into server ids
-                IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
-            }
+            msgData.ObjectId = e.NetworkId;
             NetworkMessage msg = peer->BeginSendMessage();
             msg.WriteStructure(msgData);
             BuildCachedTargets(NetworkManager::Clients, e.Targets);
@@ -1761,7 +2637,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
                     auto& item = it->Item;
 
                     // Replicate from all collected parts data
-                    InvokeObjectReplication(item, e.OwnerFrame, e.Data.Get(), e.Data.Count(), e.OwnerClientId);
+                    InvokeObjectReplication(item, e.OwnerFrame, e.BaselineOffset, e.Data.Get(), e.Data.Count(), e.OwnerClientId, e.ObjectId);
                 }
             }
 
@@ -1797,6 +2673,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
             {
                 // Object got deleted
                 NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Remove object {}, owned by {}", item.ToString(), item.ParentId.ToString());
+                ReleaseNetworkObjectId(item.ObjectId);
                 Objects.Remove(it);
                 continue;
             }
@@ -1805,14 +2682,52 @@ void NetworkInternal::NetworkReplicatorUpdate()
             CachedReplicationResult->AddObject(obj);
         }
     }
+    if (DelayedObjects.HasItems())
+    {
+        // Send objects delayed in the previous update only to the clients that missed it (unless object got updated anyway)
+        PROFILE_CPU_NAMED("ReplicationDelayed");
+        for (auto& e : CachedReplicationResult->_entries)
+        {
+            auto it = Objects.Find(e.Object->GetID());
+            if (it.IsNotEnd() && it->Item.DelayedClients)
+            {
+                NetworkClientsMask& delayedClients = it->Item.DelayedClients;
+                e.TargetClients.Word0 |= delayedClients.Word0;
+                e.TargetClients.Word1 |= delayedClients.Word1;
+                delayedClients = NetworkClientsMask();
+            }
+        }
+        for (const ReplicationDelayedItem& e : DelayedObjects)
+        {
+            auto it = Objects.Find(e.ObjectId);
+            if (it.IsEnd() || !it->Item.DelayedClients)
+                continue;
+            auto& item = it->Item;
+            ScriptingObject* obj = item.Object.Get();
+            if (obj && item.Role == NetworkObjectRole::OwnedAuthoritative)
+            {
+                CachedReplicationResult->AddObject(obj, item.DelayedClients, e.Priority);
+                CachedReplicationResult->_entries.Last().CullDistance = e.CullDistance;
+            }
+            item.DelayedClients = NetworkClientsMask();
+        }
+        DelayedObjects.Clear();
+    }
     if (CachedReplicationResult->_entries.HasItems())
     {
         PROFILE_CPU_NAMED("Replication");
-        if (CachedWriteStream == nullptr)
-            CachedWriteStream = New<NetworkStream>();
-        NetworkStream* stream = CachedWriteStream;
-        stream->SenderId = NetworkManager::LocalClientId;
-        // TODO: use Job System when replicated objects count is large
+
+        // Declare ids of all replicated objects at once
+        for (auto& e : CachedReplicationResult->_entries)
+        {
+            auto it = Objects.Find(e.Object->GetID());
+            if (it.IsNotEnd())
+                GetNetworkObjectId(it->Item);
+        }
+        SendNetworkIds();
+
+        // Collect objects to serialize (objects serializers are resolved before the parallel stage, nested ones invoked by the serializers are locked)
+        CachedSerializeItems.Clear();
         for (auto& e : CachedReplicationResult->_entries)
         {
             ScriptingObject* obj = e.Object;
@@ -1829,82 +2744,178 @@ void NetworkInternal::NetworkReplicatorUpdate()
                     continue;
             }
 
+            Serializer serializer;
+            if (!FindSerializer(obj->GetTypeHandle(), serializer))
+            {
+                //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
+                continue;
+            }
+
             if (item.AsNetworkObject)
                 item.AsNetworkObject->OnNetworkSerialize();
 
-            // Serialize object
+            auto& serializeItem = CachedSerializeItems.AddOne();
+            serializeItem.Item = &item;
+            serializeItem.Object = obj;
+            serializeItem.TargetClients = e.TargetClients;
+            serializeItem.Priority = e.Priority;
+            serializeItem.CullDistance = e.CullDistance;
+            serializeItem.ObjectSerializer = serializer;
+        }
+
+        // Serialize objects (each job writes objects one after another into its own stream)
+        int32 jobsCount = 1;
+        if (NetworkReplicator::EnableParallelSerialization)
+            jobsCount = Math::Clamp(CachedSerializeItems.Count() / NETWORK_REPLICATION_JOB_OBJECTS, 1, JobSystem::GetThreadsCount());
+        while (CachedSerializeStreams.Count() < jobsCount)
+            CachedSerializeStreams.Add(New<NetworkStream>());
+        volatile int64 nextItem = 0;
+        const auto serializeJob = [&nextItem](int32 streamIndex)
+        {
+            NetworkStream* stream = CachedSerializeStreams.Get()[streamIndex];
             stream->Initialize();
-            const bool failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, true);
-            if (failed)
+            stream->SenderId = NetworkManager::LocalClientId;
+            Dictionary<Guid, Guid>* prevIdsMapping = Scripting::ObjectsLookupIdMapping.Get();
+            Scripting::ObjectsLookupIdMapping.Set(&IdsRemappingTable);
+            ReplicationSerializeItem* items = CachedSerializeItems.Get();
+            const int64 itemsCount = CachedSerializeItems.Count();
+            int64 start;
+            while ((start = Platform::InterlockedAdd(&nextItem, NETWORK_REPLICATION_JOB_BATCH)) < itemsCount)
             {
-                //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
-                continue;
+                const int64 end = Math::Min<int64>(start + NETWORK_REPLICATION_JOB_BATCH, itemsCount);
+                for (int64 i = start; i < end; i++)
+                {
+                    ReplicationSerializeItem& e = items[i];
+                    e.StreamIndex = streamIndex;
+                    e.Start = stream->GetPosition();
+                    e.ObjectSerializer.Methods[0](e.Object, stream, e.ObjectSerializer.Tags[0]);
+                    e.Size = stream->GetPosition() - e.Start;
+                }
+            }
+            Scripting::ObjectsLookupIdMapping.Set(prevIdsMapping);
+        };
+        if (jobsCount > 1)
+        {
+            PROFILE_CPU_NAMED("Serialize");
+            JobSystem::Execute(serializeJob, jobsCount);
+        }
+        else
+        {
+            serializeJob(0);
+        }
+
+        // Fill the bandwidth budget of each client with the highest priority objects and delay the others to the next updates
+        if (!isClient && Hierarchy && Hierarchy->ClientBudget > 0)
+        {
+            PROFILE_CPU_NAMED("Schedule");
+            const int32 budget = Hierarchy->ClientBudget;
+            const auto& viewers = CachedReplicationResult->_clients;
+            for (int32 clientIndex = 0; clientIndex < NetworkManager::Clients.Count(); clientIndex++)
+            {
+                const NetworkClient* client = NetworkManager::Clients[clientIndex];
+                const bool hasLocation = clientIndex < viewers.Count() && viewers[clientIndex].HasLocation;
+                CachedScheduleItems.Clear();
+                for (int32 i = 0; i < CachedSerializeItems.Count(); i++)
+                {
+                    ReplicationSerializeItem& e = CachedSerializeItems.Get()[i];
+                    if (!e.TargetClients.HasBit(clientIndex) || !IsReplicationTarget(*e.Item, client))
+                        continue;
+
+                    // Closer objects are more important for the viewer
+                    float priority = e.Priority;
+                    if (hasLocation && e.CullDistance > 0.0f)
+                    {
+                        if (const Actor* actor = NetworkReplicationHierarchyObject(e.Object).GetActor())
+                        {
+                            const float distance = (float)Vector3::Distance(actor->GetPosition(), viewers[clientIndex].Location);
+                            priority *= Math::Max(1.0f - distance / e.CullDistance, 0.1f);
+                        }
+                    }
+
+                    // Objects delayed in the previous updates gain priority over time
+                    float& accumulated = GetReplicationPriority(*e.Item, client->ClientId);
+                    accumulated += priority;
+
+                    // Charge the budget with the data that will be actually sent to this client (delta-compressed against its baseline)
+                    const byte* data = CachedSerializeStreams.Get()[e.StreamIndex]->GetBuffer() + e.Start;
+                    const uint32 size = GetReplicationSendSize(data, e.Size, GetReplicationBaseline(*e.Item, client->ClientId));
+                    CachedScheduleItems.Add({ i, size, accumulated, &accumulated });
+                }
+                Sorting::QuickSort(CachedScheduleItems);
+                int32 budgetLeft = budget;
+                for (const ReplicationScheduleItem& s : CachedScheduleItems)
+                {
+                    ReplicationSerializeItem& e = CachedSerializeItems.Get()[s.Index];
+                    if ((int32)s.Size <= budgetLeft || budgetLeft == budget)
+                    {
+                        // Send (always send at least one object to prevent starvation of objects larger than the budget)
+                        budgetLeft -= (int32)s.Size;
+                        *s.Accumulated = 0.0f;
+                    }
+                    else
+                    {
+                        // Delay
+                        e.TargetClients.UnsetBit(clientIndex);
+                        if (!e.Item->DelayedClients)
+                            DelayedObjects.Add({ e.Item->ObjectId, e.Priority, e.CullDistance });
+                        e.Item->DelayedClients.SetBit(clientIndex);
+                    }
+                }
+            }
+        }
+
+        // Send messages in the order of the replicated objects
+        for (const ReplicationSerializeItem& e : CachedSerializeItems)
+        {
+            ScriptingObject* obj = e.Object;
+            auto& item = *e.Item;
+            if (!isClient)
+            {
+                BuildCachedTargets(item, e.TargetClients);
+                if (CachedTargets.Count() == 0)
+                    continue;
             }
+            const byte* data = CachedSerializeStreams.Get()[e.StreamIndex]->GetBuffer() + e.Start;
+            const uint32 size = e.Size;
 
-            // Send object to clients
-            const uint32 size = stream->GetPosition();
+            // Send object to clients (delta-compressed against the latest state acknowledged by the receiver)
             ASSERT(size <= MAX_uint16);
             NetworkMessageObjectReplicate msgData;
             msgData.OwnerFrame = NetworkManager::Frame;
-            msgData.ObjectId = item.ObjectId;
-            msgData.ParentId = item.ParentId;
+            msgData.ObjectId = GetNetworkObjectId(item);
+            uint32 dataSize = 0, messageSize = 0;
             if (isClient)
             {
-                // Remap local client object ids into server ids
-                IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
-                IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
-            }
-            GetNetworkName(msgData.ObjectTypeName, obj->GetType().Fullname);
-            msgData.DataSize = size;
-            const uint32 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
-            const uint32 partMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicatePart);
-            uint32 partsCount = 1;
-            uint32 dataStart = 0;
-            uint32 msgDataSize = size;
-            if (size > msgMaxData)
-            {
-                // Send msgMaxData within first message
-                msgDataSize = msgMaxData;
-                dataStart += msgMaxData;
-
-                // Send rest of the data in separate parts
-                partsCount += Math::DivideAndRoundUp(size - dataStart, partMaxData);
+                const ReplicationSnapshot* baseline = GetReplicationBaseline(item, NetworkManager::ServerClientId);
+                SendObjectReplicateMessage(msgData, data, size, baseline, nullptr, dataSize, messageSize);
             }
             else
-                dataStart += size;
-            ASSERT(partsCount <= MAX_uint8);
-            msgData.PartsCount = partsCount;
-            NetworkMessage msg = peer->BeginSendMessage();
-            msg.WriteStructure(msgData);
-            msg.WriteBytes(stream->GetBuffer(), msgDataSize);
-            uint32 dataSize = msgDataSize, messageSize = msg.Length;
-            if (isClient)
-                peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
-            else
-                peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
-
-            // Send all other parts
-            for (uint32 partIndex = 1; partIndex < partsCount; partIndex++)
             {
-                NetworkMessageObjectReplicatePart msgDataPart;
-                msgDataPart.OwnerFrame = msgData.OwnerFrame;
-                msgDataPart.ObjectId = msgData.ObjectId;
-                msgDataPart.DataSize = msgData.DataSize;
-                msgDataPart.PartsCount = msgData.PartsCount;
-                msgDataPart.PartStart = dataStart;
-                msgDataPart.PartSize = Math::Min(size - dataStart, partMaxData);
-                msg = peer->BeginSendMessage();
-                msg.WriteStructure(msgDataPart);
-                msg.WriteBytes(stream->GetBuffer() + msgDataPart.PartStart, msgDataPart.PartSize);
-                messageSize += msg.Length;
-                dataSize += msgDataPart.PartSize;
-                dataStart += msgDataPart.PartSize;
-                if (isClient)
-                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
-                else
-                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
+                // Group clients that share the same baseline to send a single message to all of them
+                int32 groupsCount = 0;
+                for (int32 i = 0; i < CachedTargetClients.Count(); i++)
+                {
+                    const ReplicationSnapshot* baseline = GetReplicationBaseline(item, CachedTargetClients.Get()[i]->ClientId);
+                    int32 groupIndex = 0;
+                    while (groupIndex < groupsCount && CachedReplicationGroups[groupIndex].Baseline != baseline)
+                        groupIndex++;
+                    if (groupIndex == groupsCount)
+                    {
+                        if (groupsCount == CachedReplicationGroups.Count())
+                            CachedReplicationGroups.AddOne();
+                        auto& group = CachedReplicationGroups[groupsCount++];
+                        group.Baseline = baseline;
+                        group.Targets.Clear();
+                    }
+                    CachedReplicationGroups[groupIndex].Targets.Add(CachedTargets.Get()[i]);
+                }
+                for (int32 groupIndex = 0; groupIndex < groupsCount; groupIndex++)
+                {
+                    const auto& group = CachedReplicationGroups[groupIndex];
+                    SendObjectReplicateMessage(msgData, data, size, group.Baseline, &group.Targets, dataSize, messageSize);
+                }
             }
-            ASSERT_LOW_LAYER(dataStart == size);
+            AddReplicationSnapshot(item, NetworkManager::LocalClientId, msgData.OwnerFrame, data, size);
 
 #if COMPILE_WITH_PROFILER
             // Network stats recording
@@ -1925,6 +2936,17 @@ void NetworkInternal::NetworkReplicatorUpdate()
     {
         PROFILE_CPU_NAMED("Rpc");
         for (auto& e : RpcQueue)
+        {
+            ScriptingObject* obj = e.Object.Get();
+            auto it = obj ? Objects.Find(obj->GetID()) : Objects.End();
+            if (it.IsNotEnd())
+            {
+                GetNetworkObjectId(it->Item);
+                GetNetworkRpcId(e.Name);
+            }
+        }
+        SendNetworkIds();
+        for (auto& e : RpcQueue)
         {
             ScriptingObject* obj = e.Object.Get();
             if (!obj)
@@ -1943,17 +2965,8 @@ void NetworkInternal::NetworkReplicatorUpdate()
             // Send RPC message
             //NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Rpc {}::{} object ID={}", e.Name.First.ToString(), String(e.Name.Second), item.ToString());
             NetworkMessageObjectRpc msgData;
-            msgData.ObjectId = item.ObjectId;
-            msgData.ParentId = item.ParentId;
-            if (isClient)
-            {
-                // Remap local client object ids into server ids
-                IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
-                IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
-            }
-            GetNetworkName(msgData.ObjectTypeName, obj->GetType().Fullname);
-            GetNetworkName(msgData.RpcTypeName, e.Name.First.GetType().Fullname);
-            GetNetworkName(msgData.RpcName, e.Name.Second);
+            msgData.ObjectId = GetNetworkObjectId(item);
+            msgData.RpcId = GetNetworkRpcId(e.Name);
             msgData.ArgsSize = (uint16)e.ArgsData.Length();
             NetworkMessage msg = peer->BeginSendMessage();
             msg.WriteStructure(msgData);
@@ -2003,9 +3016,15 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     NetworkMessageObjectReplicate msgData;
     event.Message.ReadStructure(msgData);
     ScopeLock lock(ObjectsLock);
-    if (DespawnedObjects.Contains(msgData.ObjectId))
+    const NetworkReceivedObjectId* objectId = ResolveNetworkObjectId(client, msgData.ObjectId);
+    if (!objectId)
+    {
+        DeferMessage(event, client);
+        return;
+    }
+    if (DespawnedObjects.Contains(objectId->ObjectId))
         return; // Skip replicating not-existing objects
-    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId, msgData.ParentId, msgData.ObjectTypeName);
+    NetworkReplicatedObject* e = ResolveObject(objectId->ObjectId, objectId->ParentId, objectId->ObjectType);
     if (!e)
         return;
     auto& item = *e;
@@ -2018,7 +3037,7 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     if (msgData.PartsCount == 1)
     {
         // Replicate
-        InvokeObjectReplication(item, msgData.OwnerFrame, event.Message.Buffer + event.Message.Position, msgData.DataSize, senderClientId);
+        InvokeObjectReplication(item, msgData.OwnerFrame, msgData.BaselineOffset, event.Message.Buffer + event.Message.Position, msgData.DataSize, senderClientId, msgData.ObjectId);
     }
     else
     {
@@ -2026,6 +3045,7 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
         const uint16 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
         ReplicateItem* replicateItem = AddObjectReplicateItem(event, msgData, 0, msgMaxData, senderClientId);
         replicateItem->Object = e->Object;
+        replicateItem->BaselineOffset = msgData.BaselineOffset;
     }
 }
 
@@ -2035,7 +3055,13 @@ void NetworkInternal::OnNetworkMessageObjectReplicatePart(NetworkEvent& event, N
     NetworkMessageObjectReplicatePart msgData;
     event.Message.ReadStructure(msgData);
     ScopeLock lock(ObjectsLock);
-    if (DespawnedObjects.Contains(msgData.ObjectId))
+    const NetworkReceivedObjectId* objectId = ResolveNetworkObjectId(client, msgData.ObjectId);
+    if (!objectId)
+    {
+        DeferMessage(event, client);
+        return;
+    }
+    if (DespawnedObjects.Contains(objectId->ObjectId))
         return; // Skip replicating not-existing objects
 
     const uint32 senderClientId = client ? client->ClientId : NetworkManager::ServerClientId;
@@ -2049,19 +3075,27 @@ void NetworkInternal::OnNetworkMessageObjectSpawn(NetworkEvent& event, NetworkCl
     event.Message.ReadStructure(msgData);
     if (msgData.ItemsCount == 0)
         return;
+    ScopeLock lock(ObjectsLock);
     if (msgData.UseParts)
     {
         // Allocate spawn message parts collecting
         auto& parts = SpawnParts.AddOne();
         parts.MsgData = msgData;
+        parts.SenderClientId = client ? client->ClientId : NetworkManager::ServerClientId;
         parts.Items.Resize(msgData.ItemsCount);
         for (auto& item : parts.Items)
-            item.ObjectId = Guid::Empty; // Mark as not yet received
+            item.ObjectId = 0; // Mark as not yet received
     }
     else
     {
         const auto* msgDataItems = (NetworkMessageObjectSpawnItem*)event.Message.SkipBytes(msgData.ItemsCount * sizeof(NetworkMessageObjectSpawnItem));
-        InvokeObjectSpawn(msgData, msgDataItems);
+        Array<ObjectSpawnItem> items;
+        if (ResolveSpawnItems(client, msgDataItems, msgData.ItemsCount, items))
+        {
+            DeferMessage(event, client);
+            return;
+        }
+        InvokeObjectSpawn(msgData, items.Get());
     }
 }
 
@@ -2070,12 +3104,14 @@ void NetworkInternal::OnNetworkMessageObjectSpawnPart(NetworkEvent& event, Netwo
     PROFILE_CPU();
     NetworkMessageObjectSpawnPart msgData;
     event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    const uint32 senderClientId = client ? client->ClientId : NetworkManager::ServerClientId;
     int32 spawnPartsIndex;
     for (spawnPartsIndex = 0; spawnPartsIndex < SpawnParts.Count(); spawnPartsIndex++)
     {
         // Find spawn parts container that matches this spawn message (unique pair of sender and id assigned by sender)
         const auto& e = SpawnParts.Get()[spawnPartsIndex];
-        if (e.MsgData.OwnerClientId == msgData.OwnerClientId && e.MsgData.OwnerSpawnId == msgData.OwnerSpawnId)
+        if (e.MsgData.OwnerClientId == msgData.OwnerClientId && e.MsgData.OwnerSpawnId == msgData.OwnerSpawnId && e.SenderClientId == senderClientId)
             break;
     }
     if (spawnPartsIndex >= SpawnParts.Count())
@@ -2085,21 +3121,43 @@ void NetworkInternal::OnNetworkMessageObjectSpawnPart(NetworkEvent& event, Netwo
     }
     auto& spawnParts = SpawnParts.Get()[spawnPartsIndex];
 
-    // Read all items from this part
+    // Wait for all objects from this part to be declared by the sender
     constexpr uint32 spawnItemMaxSize = sizeof(uint16) + sizeof(NetworkMessageObjectSpawnItem); // Index + Data
-    while (event.Message.Position + spawnItemMaxSize <= event.Message.BufferSize)
+    const NetworkIdsReceiveTable* ids = GetReceivedIds(client);
+    for (uint32 position = event.Message.Position; position + spawnItemMaxSize <= event.Message.Length; position += spawnItemMaxSize)
+    {
+        const auto* item = (const NetworkMessageObjectSpawnItem*)(event.Message.Buffer + position + sizeof(uint16));
+        if (!ids || !ids->Objects.ContainsKey(item->ObjectId))
+        {
+            DeferMessage(event, client);
+            return;
+        }
+    }
+
+    // Read all items from this part
+    while (event.Message.Position + spawnItemMaxSize <= event.Message.Length)
     {
         const uint16 itemIndex = event.Message.ReadUInt16();
+        if (itemIndex >= spawnParts.Items.Count())
+            return;
         event.Message.ReadStructure(spawnParts.Items[itemIndex]);
     }
 
     // Invoke spawning if we've got all items
     for (auto& e : spawnParts.Items)
     {
-        if (!e.ObjectId.IsValid())
+        if (e.ObjectId == 0)
             return;
     }
-    InvokeObjectSpawn(spawnParts.MsgData, spawnParts.Items.Get());
+    Array<ObjectSpawnItem> items;
+    if (ResolveSpawnItems(client, spawnParts.Items.Get(), spawnParts.Items.Count(), items))
+    {
+        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to spawn objects (unknown network id)");
+    }
+    else
+    {
+        InvokeObjectSpawn(spawnParts.MsgData, items.Get());
+    }
     SpawnParts.RemoveAt(spawnPartsIndex);
 }
 
@@ -2109,7 +3167,14 @@ void NetworkInternal::OnNetworkMessageObjectDespawn(NetworkEvent& event, Network
     NetworkMessageObjectDespawn msgData;
     event.Message.ReadStructure(msgData);
     ScopeLock lock(ObjectsLock);
-    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId);
+    const NetworkReceivedObjectId* objectIdPtr = ResolveNetworkObjectId(client, msgData.ObjectId);
+    if (!objectIdPtr)
+    {
+        DeferMessage(event, client);
+        return;
+    }
+    const Guid objectId = objectIdPtr->ObjectId;
+    NetworkReplicatedObject* e = ResolveObject(objectId);
     if (e)
     {
         auto& item = *e;
@@ -2122,18 +3187,19 @@ void NetworkInternal::OnNetworkMessageObjectDespawn(NetworkEvent& event, Network
             return;
 
         // Remove object
-        NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Despawn object {}", msgData.ObjectId);
+        NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Despawn object {}", objectId);
         if (Hierarchy && item.Role == NetworkObjectRole::OwnedAuthoritative)
             Hierarchy->RemoveObject(obj);
-        DespawnedObjects.Add(msgData.ObjectId);
+        DespawnedObjects.Add(objectId);
         if (item.AsNetworkObject)
             item.AsNetworkObject->OnNetworkDespawn();
         Objects.Remove(obj);
         DeleteNetworkObject(obj);
+        GetReceivedIds(client)->Objects.Remove(msgData.ObjectId);
     }
     else
     {
-        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to despawn object {}", msgData.ObjectId);
+        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Failed to despawn object {}", objectId);
     }
 }
 
@@ -2143,7 +3209,13 @@ void NetworkInternal::OnNetworkMessageObjectRole(NetworkEvent& event, NetworkCli
     NetworkMessageObjectRole msgData;
     event.Message.ReadStructure(msgData);
     ScopeLock lock(ObjectsLock);
-    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId);
+    const NetworkReceivedObjectId* objectId = ResolveNetworkObjectId(client, msgData.ObjectId);
+    if (!objectId)
+    {
+        DeferMessage(event, client);
+        return;
+    }
+    NetworkReplicatedObject* e = ResolveObject(objectId->ObjectId);
     if (e)
     {
         auto& item = *e;
@@ -2181,7 +3253,7 @@ void NetworkInternal::OnNetworkMessageObjectRole(NetworkEvent& event, NetworkCli
     }
     else
     {
-        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object role update {}", msgData.ObjectId);
+        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object role update {}", objectId->ObjectId);
     }
 }
 
@@ -2191,19 +3263,24 @@ void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClie
     NetworkMessageObjectRpc msgData;
     event.Message.ReadStructure(msgData);
     ScopeLock lock(ObjectsLock);
+    const NetworkIdsReceiveTable* ids = GetReceivedIds(client);
+    const NetworkReceivedObjectId* objectId = ids ? ids->Objects.TryGet(msgData.ObjectId) : nullptr;
+    const NetworkRpcName* name = ids ? ids->Rpcs.TryGet(msgData.RpcId) : nullptr;
+    if (!objectId || !name)
+    {
+        DeferMessage(event, client);
+        return;
+    }
 
     // Find RPC info
-    NetworkRpcName name;
-    name.First = Scripting::FindScriptingType(msgData.RpcTypeName);
-    name.Second = msgData.RpcName;
-    const NetworkRpcInfo* info = NetworkRpcInfo::RPCsTable.TryGet(name);
+    const NetworkRpcInfo* info = name->First ? NetworkRpcInfo::RPCsTable.TryGet(*name) : nullptr;
     if (!info)
     {
-        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown RPC {}::{} for object {}", String(msgData.RpcTypeName), String(msgData.RpcName), msgData.ObjectId);
+        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown RPC {} for object {}", msgData.RpcId, objectId->ObjectId);
         return;
     }
 
-    NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId, msgData.ParentId, msgData.ObjectTypeName);
+    NetworkReplicatedObject* e = ResolveObject(objectId->ObjectId, objectId->ParentId, objectId->ObjectType);
     if (e)
     {
         auto& item = *e;
@@ -2211,16 +3288,15 @@ void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClie
         if (!obj)
             return;
 
-        
         // Validate RPC
         if (info->Server && NetworkManager::IsClient())
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke server RPC {}::{} on client", String(msgData.RpcTypeName), String(msgData.RpcName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke server RPC {}::{} on client", name->First.ToString(), String(name->Second));
             return;
         }
         if (info->Client && NetworkManager::IsServer())
         {
-            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke client RPC {}::{} on server", String(msgData.RpcTypeName), String(msgData.RpcName));
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot invoke client RPC {}::{} on server", name->First.ToString(), String(name->Second));
             return;
         }
 
@@ -2234,8 +3310,116 @@ void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClie
         // Execute RPC
         info->Execute(obj, stream, info->Tag);
     }
-    else if(info->Channel != static_cast<uint8>(NetworkChannelType::Unreliable) && info->Channel != static_cast<uint8>(NetworkChannelType::UnreliableOrdered))
+    else if (info->Channel != static_cast<uint8>(NetworkChannelType::Unreliable) && info->Channel != static_cast<uint8>(NetworkChannelType::UnreliableOrdered))
+    {
+        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}::{}", objectId->ObjectId, name->First.ToString(), String(name->Second));
+    }
+}
+
+void NetworkInternal::OnNetworkMessageObjectIds(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectIds msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    const uint32 senderClientId = client ? client->ClientId : NetworkManager::ServerClientId;
+    NetworkIdsReceiveTable* ids;
+    if (!ReceivedIds.TryGet(senderClientId, ids))
+    {
+        ids = New<NetworkIdsReceiveTable>();
+        ReceivedIds.Add(senderClientId, ids);
+    }
+    for (uint16 i = 0; i < msgData.RecordsCount; i++)
+    {
+        switch ((NetworkIdsRecordType)event.Message.ReadUInt8())
+        {
+        case NetworkIdsRecordType::Type:
+        {
+            const uint16 id = event.Message.ReadUInt16();
+            const uint16 nameLength = event.Message.ReadUInt16();
+            const StringAnsiView name((const char*)event.Message.SkipBytes(nameLength), nameLength);
+            const ScriptingTypeHandle type = Scripting::FindScriptingType(name);
+            if (!type)
+            {
+                NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown type {}", String(name));
+            }
+            ids->Types[id] = type;
+            break;
+        }
+        case NetworkIdsRecordType::Rpc:
+        {
+            const uint16 id = event.Message.ReadUInt16();
+            const uint16 typeId = event.Message.ReadUInt16();
+            const uint16 nameLength = event.Message.ReadUInt16();
+            const StringAnsiView name((const char*)event.Message.SkipBytes(nameLength), nameLength);
+
+            // Use name from the RPCs table to be sure that text stays alive
+            NetworkRpcName rpcName;
+            ids->Types.TryGet(typeId, rpcName.First);
+            const auto it = NetworkRpcInfo::RPCsTable.Find(NetworkRpcName(rpcName.First, name));
+            if (it.IsNotEnd())
+                rpcName = it->Key;
+            else
+            {
+                rpcName.First = ScriptingTypeHandle();
+                NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown RPC {} (type id {})", String(name), typeId);
+            }
+            ids->Rpcs[id] = rpcName;
+            break;
+        }
+        case NetworkIdsRecordType::Object:
+        {
+            const uint32 id = event.Message.ReadUInt32();
+            NetworkReceivedObjectId& objectId = ids->Objects[id];
+            objectId.ObjectId = event.Message.ReadGuid();
+            objectId.ParentId = event.Message.ReadGuid();
+            objectId.ObjectType = ScriptingTypeHandle();
+            ids->Types.TryGet(event.Message.ReadUInt16(), objectId.ObjectType);
+            break;
+        }
+        default:
+            return;
+        }
+    }
+
+    // Process messages that were waiting for these ids
+    InvokeDeferredMessages(senderClientId);
+}
+
+void NetworkInternal::OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectReplicateAck msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    const uint32 clientId = client ? client->ClientId : NetworkManager::ServerClientId;
+    for (int32 i = 0; i < msgData.ItemsCount; i++)
     {
-        NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}::{}", msgData.ObjectId, String(msgData.RpcTypeName), String(msgData.RpcName));
+        NetworkMessageObjectReplicateAckItem msgDataItem;
+        event.Message.ReadStructure(msgDataItem);
+        const Guid* objectId = SendIds.ObjectsById.TryGet(msgDataItem.ObjectId);
+        if (!objectId)
+            continue;
+        auto it = Objects.Find(*objectId);
+        if (it.IsEnd())
+            continue;
+        auto& item = it->Item;
+
+        // Update the latest state acknowledged by the receiver (zero frame resets baseline to send the full state)
+        int32 baselineIndex = 0;
+        while (baselineIndex < item.Baselines.Count() && item.Baselines[baselineIndex].ClientId != clientId)
+            baselineIndex++;
+        if (msgDataItem.OwnerFrame == 0)
+        {
+            if (baselineIndex < item.Baselines.Count())
+                item.Baselines.RemoveAt(baselineIndex);
+        }
+        else if (FindReplicationSnapshot(item, NetworkManager::LocalClientId, msgDataItem.OwnerFrame))
+        {
+            if (baselineIndex == item.Baselines.Count())
+                item.Baselines.Add({ clientId, msgDataItem.OwnerFrame });
+            else if (item.Baselines[baselineIndex].Frame < msgDataItem.OwnerFrame)
+                item.Baselines[baselineIndex].Frame = msgDataItem.OwnerFrame;
+        }
     }
 }
@@ -42,6 +42,11 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     API_FIELD() static bool EnableLog;
 #endif
 
+    /// <summary>
+    /// Enables serializing replicated objects on Job System threads when many objects are replicated at once. Object serializers must be safe to call concurrently for different objects (INetworkObject.OnNetworkSerialize is still called on the main thread). Disable it to serialize all objects on the main thread.
+    /// </summary>
+    API_FIELD() static bool EnableParallelSerialization;
+
     /// <summary>
     /// Gets the network replication hierarchy.
     /// </summary>
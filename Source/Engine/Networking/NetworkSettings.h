@@ -44,6 +44,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings") class FLAXENGINE_API
     API_FIELD(Attributes="EditorOrder(1010), EditorDisplay(\"Transport\")")
     uint16 Port = 7777;
 
+    /// <summary>
+    /// Enables batching multiple small messages into a single packet to reduce the amount of packets sent over the network (eg. when replicating many objects). Server and clients must use the same setting.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1020), EditorDisplay(\"Transport\")")
+    bool MessageBatching = false;
+
     /// <summary>
     /// The type of the network driver (implements INetworkDriver) that will be used to create, manage, send and receive messages over the network.
     /// </summary>
@@ -33,3 +33,42 @@ struct TIsPODType<NetworkDriverStats>
 {
     enum { Value = true };
 };
+
+/// <summary>
+/// The network peer statistics container. Contains information about messages and packets sent and received by the NetworkPeer.
+/// </summary>
+API_STRUCT(Namespace="FlaxEngine.Networking", NoDefault) struct FLAXENGINE_API NetworkPeerStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(NetworkPeerStats);
+
+    /// <summary>
+    /// Total amount of messages sent by this peer. Message sent to multiple connections is counted once per each target.
+    /// </summary>
+    API_FIELD() uint32 MessagesSent = 0;
+
+    /// <summary>
+    /// Total amount of packets sent by this peer via the network driver.
+    /// </summary>
+    API_FIELD() uint32 PacketsSent = 0;
+
+    /// <summary>
+    /// Total amount of packets saved by batching multiple messages into a single packet (see NetworkConfig.MessageBatching).
+    /// </summary>
+    API_FIELD() uint32 PacketsSaved = 0;
+
+    /// <summary>
+    /// Total amount of messages received by this peer.
+    /// </summary>
+    API_FIELD() uint32 MessagesReceived = 0;
+
+    /// <summary>
+    /// Total amount of packets received by this peer via the network driver.
+    /// </summary>
+    API_FIELD() uint32 PacketsReceived = 0;
+};
+
+template<>
+struct TIsPODType<NetworkPeerStats>
+{
+    enum { Value = true };
+};
@@ -18,4 +18,5 @@ struct NetworkConnection;
 struct NetworkMessage;
 struct NetworkConfig;
 struct NetworkDriverStats;
+struct NetworkPeerStats;
 struct NetworkRpcParams;
@@ -16,6 +16,7 @@
 SplineCollider::SplineCollider(const SpawnParams& params)
     : Collider(params)
 {
+    Flags |= ObjectFlags::NoAsyncDeserialize; // Reads the parent spline data when linked to it
     CollisionData.Changed.Bind<SplineCollider, &SplineCollider::OnCollisionDataChanged>(this);
     CollisionData.Loaded.Bind<SplineCollider, &SplineCollider::OnCollisionDataLoaded>(this);
 }
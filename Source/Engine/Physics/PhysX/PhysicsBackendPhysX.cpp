@@ -21,10 +21,10 @@
 #include "Engine/Physics/Joints/SphericalJoint.h"
 #include "Engine/Physics/Joints/D6Joint.h"
 #include "Engine/Physics/Colliders/Collider.h"
-#include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/WriteStream.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/PhysX/PxPhysicsAPI.h>
 #include <ThirdParty/PhysX/PxQueryFiltering.h>
 #include <ThirdParty/PhysX/extensions/PxFixedJoint.h>
@@ -44,7 +44,6 @@
 #endif
 #if WITH_CLOTH
 #include "Engine/Physics/Actors/Cloth.h"
-#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/NvCloth/Callbacks.h>
 #include <ThirdParty/NvCloth/Factory.h>
@@ -122,6 +121,39 @@ class AllocatorPhysX : public PxAllocatorCallback
     }
 };
 
+class CpuDispatcherPhysX : public PxCpuDispatcher
+{
+private:
+    volatile int64 _tasksCount = 0;
+
+public:
+    void submitTask(PxBaseTask& task) override
+    {
+        // PhysX tasks never wait for each other (continuations are submitted when the dependencies end) so they can share the engine job threads with other systems
+        PxBaseTask* taskPtr = &task;
+        Platform::InterlockedIncrement(&_tasksCount);
+        JobSystem::Dispatch([this, taskPtr](int32)
+        {
+            PROFILE_CPU_NAMED("PhysX.Task");
+            taskPtr->run();
+            taskPtr->release();
+            Platform::InterlockedDecrement(&_tasksCount);
+        }, 1, JobPriority::Normal);
+    }
+
+    void WaitForTasks() const
+    {
+        // Wait only for the tasks submitted by this dispatcher (other jobs may run for long)
+        while (Platform::AtomicRead(&_tasksCount) != 0)
+            Platform::Sleep(0);
+    }
+
+    uint32_t getWorkerCount() const override
+    {
+        return JobSystem::GetThreadsCount();
+    }
+};
+
 class ErrorPhysX : public PxErrorCallback
 {
     void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line) override
@@ -1267,8 +1299,7 @@ void* PhysicsBackend::CreateScene(const PhysicsSettings& settings)
     }
     if (sceneDesc.cpuDispatcher == nullptr)
     {
-        scenePhysX->CpuDispatcher = PxDefaultCpuDispatcherCreate(Math::Clamp<uint32>(Platform::GetCPUInfo().ProcessorCoreCount - 1, 1, 4));
-        CHECK_INIT(scenePhysX->CpuDispatcher, "PxDefaultCpuDispatcherCreate failed!");
+        scenePhysX->CpuDispatcher = New<CpuDispatcherPhysX>();
         sceneDesc.cpuDispatcher = scenePhysX->CpuDispatcher;
     }
     switch (settings.BroadPhaseType)
@@ -1331,6 +1362,8 @@ void PhysicsBackend::DestroyScene(void* scene)
     }
 #endif
     RELEASE_PHYSX(scenePhysX->ControllerManager);
+    if (scenePhysX->CpuDispatcher)
+        ((CpuDispatcherPhysX*)scenePhysX->CpuDispatcher)->WaitForTasks();
     SAFE_DELETE(scenePhysX->CpuDispatcher);
     Allocator::Free(scenePhysX->ScratchMemory);
     scenePhysX->Scene->release();
@@ -2316,6 +2349,94 @@ bool PhysicsBackend::OverlapConvex(void* scene, const Vector3& center, const Col
     return true;
 }
 
+int32 PhysicsBackend::RayCastBatch(void* scene, const RayCastQuery* queries, RayCastHit* results, int32 count, uint32 layerMask, bool hitTriggers)
+{
+    if (scene == nullptr)
+    {
+        // Clear results so the caller doesn't read uninitialized hits
+        for (int32 i = 0; i < count; i++)
+            results[i] = RayCastHit();
+        return 0;
+    }
+    SCENE_QUERY_SETUP(true);
+    int32 hits = 0;
+    for (int32 i = 0; i < count; i++)
+    {
+        const RayCastQuery& query = queries[i];
+        RayCastHit& hitInfo = results[i];
+        PxRaycastBuffer buffer;
+        if (scenePhysX->Scene->raycast(C2P(query.Origin - scenePhysX->Origin), C2P(query.Direction), query.MaxDistance, buffer, SCENE_QUERY_FLAGS, filterData, &QueryFilter))
+        {
+            SCENE_QUERY_COLLECT_SINGLE();
+            hits++;
+        }
+        else
+        {
+            hitInfo = RayCastHit();
+        }
+    }
+    return hits;
+}
+
+int32 PhysicsBackend::SphereCastBatch(void* scene, const SphereCastQuery* queries, RayCastHit* results, int32 count, uint32 layerMask, bool hitTriggers)
+{
+    if (scene == nullptr)
+    {
+        // Clear results so the caller doesn't read uninitialized hits
+        for (int32 i = 0; i < count; i++)
+            results[i] = RayCastHit();
+        return 0;
+    }
+    SCENE_QUERY_SETUP(true);
+    int32 hits = 0;
+    for (int32 i = 0; i < count; i++)
+    {
+        const SphereCastQuery& query = queries[i];
+        RayCastHit& hitInfo = results[i];
+        PxSweepBufferN<1> buffer;
+        const PxTransform pose(C2P(query.Center - scenePhysX->Origin));
+        const PxSphereGeometry geometry(query.Radius);
+        if (scenePhysX->Scene->sweep(geometry, pose, C2P(query.Direction), query.MaxDistance, buffer, SCENE_QUERY_FLAGS, filterData, &QueryFilter))
+        {
+            SCENE_QUERY_COLLECT_SINGLE();
+            hits++;
+        }
+        else
+        {
+            hitInfo = RayCastHit();
+        }
+    }
+    return hits;
+}
+
+int32 PhysicsBackend::OverlapSphereBatch(void* scene, const BoundingSphere* spheres, PhysicsColliderActor** results, int32 count, uint32 layerMask, bool hitTriggers)
+{
+    if (scene == nullptr)
+    {
+        // Clear results so the caller doesn't read uninitialized hits
+        for (int32 i = 0; i < count; i++)
+            results[i] = nullptr;
+        return 0;
+    }
+    SCENE_QUERY_SETUP(false);
+    int32 hits = 0;
+    for (int32 i = 0; i < count; i++)
+    {
+        const BoundingSphere& sphere = spheres[i];
+        PxOverlapBufferN<1> buffer;
+        const PxTransform pose(C2P(sphere.Center - scenePhysX->Origin));
+        const PxSphereGeometry geometry((float)sphere.Radius);
+        results[i] = nullptr;
+        if (scenePhysX->Scene->overlap(geometry, pose, buffer, filterData, &QueryFilter) && buffer.getNbAnyHits() != 0)
+        {
+            const auto& hit = buffer.getAnyHit(0);
+            results[i] = hit.shape ? static_cast<PhysicsColliderActor*>(hit.shape->userData) : nullptr;
+            hits++;
+        }
+    }
+    return hits;
+}
+
 PhysicsBackend::ActorFlags PhysicsBackend::GetActorFlags(void* actor)
 {
     auto actorPhysX = (PxActor*)actor;
@@ -11,6 +11,10 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
+
+// Minimum amount of the batched scene queries executed by a single job
+#define PHYSICS_BATCH_QUERY_GRAIN 64
 
 PhysicsScene* Physics::DefaultScene = nullptr;
 Array<PhysicsScene*> Physics::Scenes;
@@ -368,6 +372,21 @@ bool Physics::OverlapConvex(const Vector3& center, const CollisionData* convexMe
     return DefaultScene->OverlapConvex(center, convexMesh, scale, results, rotation, layerMask, hitTriggers);
 }
 
+int32 Physics::RayCastBatch(const Span<RayCastQuery>& queries, Array<RayCastHit>& results, uint32 layerMask, bool hitTriggers, bool parallel)
+{
+    return DefaultScene->RayCastBatch(queries, results, layerMask, hitTriggers, parallel);
+}
+
+int32 Physics::SphereCastBatch(const Span<SphereCastQuery>& queries, Array<RayCastHit>& results, uint32 layerMask, bool hitTriggers, bool parallel)
+{
+    return DefaultScene->SphereCastBatch(queries, results, layerMask, hitTriggers, parallel);
+}
+
+int32 Physics::OverlapSphereBatch(const Span<BoundingSphere>& spheres, Array<PhysicsColliderActor*>& results, uint32 layerMask, bool hitTriggers, bool parallel)
+{
+    return DefaultScene->OverlapSphereBatch(spheres, results, layerMask, hitTriggers, parallel);
+}
+
 PhysicsScene::PhysicsScene(const SpawnParams& params)
     : ScriptingObject(params)
 {
@@ -637,3 +656,45 @@ bool PhysicsScene::OverlapConvex(const Vector3& center, const CollisionData* con
 {
     return PhysicsBackend::OverlapConvex(_scene, center, convexMesh, scale, results, rotation, layerMask, hitTriggers);
 }
+
+int32 PhysicsScene::RayCastBatch(const Span<RayCastQuery>& queries, Array<RayCastHit>& results, uint32 layerMask, bool hitTriggers, bool parallel)
+{
+    PROFILE_CPU();
+    results.Resize(queries.Length(), false);
+    if (!parallel)
+        return PhysicsBackend::RayCastBatch(_scene, queries.Get(), results.Get(), queries.Length(), layerMask, hitTriggers);
+    volatile int64 hits = 0;
+    JobSystem::ParallelFor(0, queries.Length(), PHYSICS_BATCH_QUERY_GRAIN, [&](int32 start, int32 end)
+    {
+        Platform::InterlockedAdd(&hits, PhysicsBackend::RayCastBatch(_scene, queries.Get() + start, results.Get() + start, end - start, layerMask, hitTriggers));
+    });
+    return (int32)hits;
+}
+
+int32 PhysicsScene::SphereCastBatch(const Span<SphereCastQuery>& queries, Array<RayCastHit>& results, uint32 layerMask, bool hitTriggers, bool parallel)
+{
+    PROFILE_CPU();
+    results.Resize(queries.Length(), false);
+    if (!parallel)
+        return PhysicsBackend::SphereCastBatch(_scene, queries.Get(), results.Get(), queries.Length(), layerMask, hitTriggers);
+    volatile int64 hits = 0;
+    JobSystem::ParallelFor(0, queries.Length(), PHYSICS_BATCH_QUERY_GRAIN, [&](int32 start, int32 end)
+    {
+        Platform::InterlockedAdd(&hits, PhysicsBackend::SphereCastBatch(_scene, queries.Get() + start, results.Get() + start, end - start, layerMask, hitTriggers));
+    });
+    return (int32)hits;
+}
+
+int32 PhysicsScene::OverlapSphereBatch(const Span<BoundingSphere>& spheres, Array<PhysicsColliderActor*>& results, uint32 layerMask, bool hitTriggers, bool parallel)
+{
+    PROFILE_CPU();
+    results.Resize(spheres.Length(), false);
+    if (!parallel)
+        return PhysicsBackend::OverlapSphereBatch(_scene, spheres.Get(), results.Get(), spheres.Length(), layerMask, hitTriggers);
+    volatile int64 hits = 0;
+    JobSystem::ParallelFor(0, spheres.Length(), PHYSICS_BATCH_QUERY_GRAIN, [&](int32 start, int32 end)
+    {
+        Platform::InterlockedAdd(&hits, PhysicsBackend::OverlapSphereBatch(_scene, spheres.Get() + start, results.Get() + start, end - start, layerMask, hitTriggers));
+    });
+    return (int32)hits;
+}
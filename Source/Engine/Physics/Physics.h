@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Types/Span.h"
 #include "Types.h"
 
 /// <summary>
@@ -471,4 +473,37 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
     /// <returns>True if convex mesh overlaps any matching object, otherwise false.</returns>
     API_FUNCTION() static bool OverlapConvex(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Performs multiple raycasts against objects in the scene at once. Avoids the per-call overhead of the single queries and can execute them in parallel on Job System threads.
+    /// </summary>
+    /// <param name="queries">The raycasts to perform.</param>
+    /// <param name="results">The result hit information for each query (resized to the queries count, its memory is reused between calls). Collider is null for queries that didn't hit anything.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <param name="parallel">If set to <c>true</c> queries will be split between Job System threads.</param>
+    /// <returns>The amount of queries that hit a matching object.</returns>
+    API_FUNCTION() static int32 RayCastBatch(const Span<RayCastQuery>& queries, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, uint32 layerMask = MAX_uint32, bool hitTriggers = true, bool parallel = true);
+
+    /// <summary>
+    /// Performs multiple sphere sweeps against objects in the scene at once. Avoids the per-call overhead of the single queries and can execute them in parallel on Job System threads.
+    /// </summary>
+    /// <param name="queries">The sphere casts to perform.</param>
+    /// <param name="results">The result hit information for each query (resized to the queries count, its memory is reused between calls). Collider is null for queries that didn't hit anything.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <param name="parallel">If set to <c>true</c> queries will be split between Job System threads.</param>
+    /// <returns>The amount of queries that hit a matching object.</returns>
+    API_FUNCTION() static int32 SphereCastBatch(const Span<SphereCastQuery>& queries, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, uint32 layerMask = MAX_uint32, bool hitTriggers = true, bool parallel = true);
+
+    /// <summary>
+    /// Performs multiple sphere overlap tests against objects in the scene at once. Avoids the per-call overhead of the single queries and can execute them in parallel on Job System threads.
+    /// </summary>
+    /// <param name="spheres">The spheres to test.</param>
+    /// <param name="results">The result collider for each query (resized to the queries count, its memory is reused between calls). Contains any of the overlapping colliders or null if sphere doesn't overlap anything.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <param name="parallel">If set to <c>true</c> queries will be split between Job System threads.</param>
+    /// <returns>The amount of spheres that overlap any matching object.</returns>
+    API_FUNCTION() static int32 OverlapSphereBatch(const Span<BoundingSphere>& spheres, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results, uint32 layerMask = MAX_uint32, bool hitTriggers = true, bool parallel = true);
 };
@@ -147,6 +147,9 @@ class FLAXENGINE_API PhysicsBackend
     static bool OverlapSphere(void* scene, const Vector3& center, float radius, Array<PhysicsColliderActor*, HeapAllocation>& results, uint32 layerMask, bool hitTriggers);
     static bool OverlapCapsule(void* scene, const Vector3& center, float radius, float height, Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers);
     static bool OverlapConvex(void* scene, const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation, uint32 layerMask, bool hitTriggers);
+    static int32 RayCastBatch(void* scene, const RayCastQuery* queries, RayCastHit* results, int32 count, uint32 layerMask, bool hitTriggers);
+    static int32 SphereCastBatch(void* scene, const SphereCastQuery* queries, RayCastHit* results, int32 count, uint32 layerMask, bool hitTriggers);
+    static int32 OverlapSphereBatch(void* scene, const BoundingSphere* spheres, PhysicsColliderActor** results, int32 count, uint32 layerMask, bool hitTriggers);
 
     // Actors
     static ActorFlags GetActorFlags(void* actor);
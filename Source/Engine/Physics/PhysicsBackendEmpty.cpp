@@ -266,6 +266,27 @@ bool PhysicsBackend::OverlapConvex(void* scene, const Vector3& center, const Col
     return false;
 }
 
+int32 PhysicsBackend::RayCastBatch(void* scene, const RayCastQuery* queries, RayCastHit* results, int32 count, uint32 layerMask, bool hitTriggers)
+{
+    for (int32 i = 0; i < count; i++)
+        results[i] = RayCastHit();
+    return 0;
+}
+
+int32 PhysicsBackend::SphereCastBatch(void* scene, const SphereCastQuery* queries, RayCastHit* results, int32 count, uint32 layerMask, bool hitTriggers)
+{
+    for (int32 i = 0; i < count; i++)
+        results[i] = RayCastHit();
+    return 0;
+}
+
+int32 PhysicsBackend::OverlapSphereBatch(void* scene, const BoundingSphere* spheres, PhysicsColliderActor** results, int32 count, uint32 layerMask, bool hitTriggers)
+{
+    for (int32 i = 0; i < count; i++)
+        results[i] = nullptr;
+    return 0;
+}
+
 PhysicsBackend::ActorFlags PhysicsBackend::GetActorFlags(void* actor)
 {
     return ActorFlags::None;
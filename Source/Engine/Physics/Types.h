@@ -174,6 +174,57 @@ API_STRUCT(NoDefault) struct RayCastHit
     API_FIELD() Float2 UV;
 };
 
+/// <summary>
+/// Raycast query data used by the batched scene queries.
+/// </summary>
+API_STRUCT(NoDefault) struct RayCastQuery
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(RayCastQuery);
+
+    /// <summary>
+    /// The origin of the ray.
+    /// </summary>
+    API_FIELD() Vector3 Origin;
+
+    /// <summary>
+    /// The normalized direction of the ray.
+    /// </summary>
+    API_FIELD() Vector3 Direction;
+
+    /// <summary>
+    /// The maximum distance the ray should check for collisions.
+    /// </summary>
+    API_FIELD() float MaxDistance = MAX_float;
+};
+
+/// <summary>
+/// Sphere sweep query data used by the batched scene queries.
+/// </summary>
+API_STRUCT(NoDefault) struct SphereCastQuery
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(SphereCastQuery);
+
+    /// <summary>
+    /// The sphere center.
+    /// </summary>
+    API_FIELD() Vector3 Center;
+
+    /// <summary>
+    /// The radius of the sphere.
+    /// </summary>
+    API_FIELD() float Radius;
+
+    /// <summary>
+    /// The normalized direction in which cast a sphere.
+    /// </summary>
+    API_FIELD() Vector3 Direction;
+
+    /// <summary>
+    /// The maximum distance the sphere should check for collisions.
+    /// </summary>
+    API_FIELD() float MaxDistance = MAX_float;
+};
+
 /// <summary>
 /// Physics collision shape variant for different shapes such as box, sphere, capsule.
 /// </summary>
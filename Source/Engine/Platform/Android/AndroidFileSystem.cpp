@@ -573,6 +573,22 @@ bool AndroidAssetFile::Read(void* buffer, uint32 bytesToRead, uint32* bytesRead)
     return true;
 }
 
+bool AndroidAssetFile::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    // Assets are accessed via AAssetManager so use seek and read
+    return FileBase::ReadAt(buffer, bytesToRead, position, bytesRead);
+}
+
+const byte* AndroidAssetFile::Map(uint32& size)
+{
+    // Assets are accessed via AAssetManager (can be compressed inside the apk) so don't map them
+    return FileBase::Map(size);
+}
+
+void AndroidAssetFile::Unmap(const byte* data, uint32 size)
+{
+}
+
 bool AndroidAssetFile::Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten)
 {
     return true;
@@ -8,6 +8,26 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 
+bool FileBase::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    // Fallback to seek and read (not safe to be used from multiple threads)
+    const uint32 prevPosition = GetPosition();
+    SetPosition(position);
+    const bool result = Read(buffer, bytesToRead, bytesRead);
+    SetPosition(prevPosition);
+    return result;
+}
+
+const byte* FileBase::Map(uint32& size)
+{
+    size = 0;
+    return nullptr;
+}
+
+void FileBase::Unmap(const byte* data, uint32 size)
+{
+}
+
 bool FileBase::ReadAllBytes(const StringView& path, byte* data, int32 length)
 {
     PROFILE_CPU_NAMED("File::ReadAllBytes");
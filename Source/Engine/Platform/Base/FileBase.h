@@ -84,6 +84,16 @@ class FLAXENGINE_API FileBase : public NonCopyable
     /// <returns>True if cannot read data, otherwise false.</returns>
     virtual bool Read(void* buffer, uint32 bytesToRead, uint32* bytesRead = nullptr) = 0;
 
+    /// <summary>
+    /// Reads data from a file at the given position. Doesn't change the current position of the file pointer. Platforms with positional reads (eg. pread) don't seek the file so multiple threads can read from the same file at once.
+    /// </summary>
+    /// <param name="buffer">Output buffer to read data to it.</param>
+    /// <param name="bytesToRead">The maximum amount bytes to read.</param>
+    /// <param name="position">The position in the file to read from.</param>
+    /// <param name="bytesRead">A pointer to the variable that receives the number of bytes read.</param>
+    /// <returns>True if cannot read data, otherwise false.</returns>
+    virtual bool ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead = nullptr);
+
     /// <summary>
     /// Writes data to a file.
     /// </summary>
@@ -93,6 +103,21 @@ class FLAXENGINE_API FileBase : public NonCopyable
     /// <returns>True if cannot write data, otherwise false.</returns>
     virtual bool Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten = nullptr) = 0;
 
+    /// <summary>
+    /// Maps the whole file into the process memory for reading. The mapped pages are backed by the OS file cache so multiple processes that map the same file share the memory.
+    /// </summary>
+    /// <remarks>The mapped data is read-only and stays valid until Unmap is called (the file can be closed before).</remarks>
+    /// <param name="size">The mapped data size (in bytes).</param>
+    /// <returns>The mapped file data or null if cannot map the file (or platform doesn't support it).</returns>
+    virtual const byte* Map(uint32& size);
+
+    /// <summary>
+    /// Releases the file mapping created with Map.
+    /// </summary>
+    /// <param name="data">The mapped file data.</param>
+    /// <param name="size">The mapped data size (in bytes).</param>
+    virtual void Unmap(const byte* data, uint32 size);
+
     /// <summary>
     /// Close file handle
     /// </summary>
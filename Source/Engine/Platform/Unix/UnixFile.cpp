@@ -15,6 +15,7 @@
 #endif
 #include <sys/file.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <cerrno>
@@ -99,6 +100,42 @@ bool UnixFile::Read(void* buffer, uint32 bytesToRead, uint32* bytesRead)
     return true;
 }
 
+bool UnixFile::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    const ssize_t tmp = pread(_handle, buffer, bytesToRead, (off_t)position);
+    if (tmp != -1)
+    {
+        if (bytesRead)
+            *bytesRead = tmp;
+        return false;
+    }
+    if (bytesRead)
+        *bytesRead = 0;
+    LOG_UNIX_LAST_ERROR;
+    return true;
+}
+
+const byte* UnixFile::Map(uint32& size)
+{
+    size = GetSize();
+    if (size == 0)
+        return nullptr;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, _handle, 0);
+    if (data == MAP_FAILED)
+    {
+        size = 0;
+        LOG_UNIX_LAST_ERROR;
+        return nullptr;
+    }
+    return (const byte*)data;
+}
+
+void UnixFile::Unmap(const byte* data, uint32 size)
+{
+    if (data)
+        munmap((void*)data, size);
+}
+
 bool UnixFile::Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten)
 {
     const ssize_t tmp = write(_handle, buffer, bytesToWrite);
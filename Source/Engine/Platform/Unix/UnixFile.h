@@ -44,6 +44,9 @@ class FLAXENGINE_API UnixFile : public FileBase
 
     // [FileBase]
     bool Read(void* buffer, uint32 bytesToRead, uint32* bytesRead = nullptr) override;
+    bool ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead = nullptr) override;
+    const byte* Map(uint32& size) override;
+    void Unmap(const byte* data, uint32 size) override;
     bool Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten = nullptr) override;
     void Close() override;
     uint32 GetSize() const override;
@@ -50,6 +50,61 @@ bool Win32File::Read(void* buffer, uint32 bytesToRead, uint32* bytesRead)
     return true;
 }
 
+bool Win32File::ReadAt(void* buffer, uint32 bytesToRead, uint32 position, uint32* bytesRead)
+{
+    // Read at the offset (synchronous file handle moves the file pointer so restore it)
+    const DWORD prevPosition = SetFilePointer(_handle, 0, nullptr, FILE_CURRENT);
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = position;
+    DWORD tmp;
+    const BOOL result = ReadFile(_handle, buffer, bytesToRead, &tmp, &overlapped);
+    SetFilePointer(_handle, prevPosition, nullptr, FILE_BEGIN);
+    if (result)
+    {
+        if (bytesRead)
+            *bytesRead = tmp;
+        return false;
+    }
+
+    if (bytesRead)
+        *bytesRead = 0;
+    return true;
+}
+
+const byte* Win32File::Map(uint32& size)
+{
+    size = GetSize();
+    if (size == 0)
+        return nullptr;
+#if PLATFORM_UWP
+    HANDLE mapping = CreateFileMappingFromApp(_handle, nullptr, PAGE_READONLY, 0, nullptr);
+#else
+    HANDLE mapping = CreateFileMappingW(_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+#endif
+    if (mapping == nullptr)
+    {
+        size = 0;
+        return nullptr;
+    }
+#if PLATFORM_UWP
+    void* data = MapViewOfFileFromApp(mapping, FILE_MAP_READ, 0, 0);
+#else
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#endif
+
+    // Mapped view keeps a reference to the mapping object
+    CloseHandle(mapping);
+    if (data == nullptr)
+        size = 0;
+    return (const byte*)data;
+}
+
+void Win32File::Unmap(const byte* data, uint32 size)
+{
+    if (data)
+        UnmapViewOfFile(data);
+}
+
 bool Win32File::Write(const void* buffer, uint32 bytesToWrite, uint32* bytesWritten)
 {
     // Try to write data
@@ -9,6 +9,7 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Networking/NetworkInternal.h"
+#include "Engine/Threading/JobSystem.h"
 
 ProfilingTools::MainStats ProfilingTools::Stats;
 Array<ProfilingTools::ThreadStats, InlinedAllocation<64>> ProfilingTools::EventsCPU;
@@ -51,6 +52,10 @@ void ProfilingToolsService::Update()
         float presentTime;
         ProfilerGPU::GetLastFrameData(stats.DrawGPUTimeMs, presentTime, stats.DrawStats);
         stats.DrawCPUTimeMs = Math::Max(stats.DrawCPUTimeMs - presentTime, 0.0f); // Remove swapchain present wait time to exclude from drawing on CPU
+        stats.ContentStreaming = Streaming::GetStats();
+        stats.JobsQueuedHigh = JobSystem::GetQueuedJobsCount(JobPriority::High);
+        stats.JobsQueuedNormal = JobSystem::GetQueuedJobsCount(JobPriority::Normal);
+        stats.JobsQueuedBackground = JobSystem::GetQueuedJobsCount(JobPriority::Background);
     }
 
     // Extract CPU profiler events
@@ -8,6 +8,7 @@
 #include "Engine/Platform/MemoryStats.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Profiler/Profiler.h"
+#include "Engine/Streaming/Streaming.h"
 
 /// <summary>
 /// Profiler tools for development. Allows to gather profiling data and events from the engine.
@@ -85,6 +86,26 @@ API_CLASS(Static) class FLAXENGINE_API ProfilingTools
         /// The last rendered frame stats.
         /// </summary>
         API_FIELD() RenderStatsData DrawStats;
+
+        /// <summary>
+        /// The content streaming stats (including memory budgets usage and pressure).
+        /// </summary>
+        API_FIELD() StreamingStats ContentStreaming;
+
+        /// <summary>
+        /// The amount of the High priority jobs waiting in the job system queue.
+        /// </summary>
+        API_FIELD() int32 JobsQueuedHigh;
+
+        /// <summary>
+        /// The amount of the Normal priority jobs waiting in the job system queue.
+        /// </summary>
+        API_FIELD() int32 JobsQueuedNormal;
+
+        /// <summary>
+        /// The amount of the Background priority jobs waiting in the job system queue.
+        /// </summary>
+        API_FIELD() int32 JobsQueuedBackground;
     };
 
     /// <summary>
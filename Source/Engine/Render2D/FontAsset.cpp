@@ -38,7 +38,10 @@ Asset::LoadResult FontAsset::load()
     auto chunk0 = GetChunk(0);
     if (chunk0 == nullptr || chunk0->IsMissing())
         return LoadResult::MissingDataChunk;
-    _fontFile.Swap(chunk0->Data);
+    if (chunk0->Data.IsAllocated())
+        _fontFile.Swap(chunk0->Data);
+    else
+        _fontFile.Copy(chunk0->Data); // Chunk references the memory-mapped package that can be closed
 
     // Create font face
     return Init() ? LoadResult::Failed : LoadResult::Ok;
@@ -351,11 +351,14 @@ void Script::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier
                 }
                 else
                 {
+                    // Scene objects can be deserialized on multiple threads at once (see Level::loadScene)
+                    Level::ScenesLock.Lock();
                     if (_parent)
                         _parent->Scripts.RemoveKeepOrder(this);
                     _parent = parent;
                     if (_parent)
                         _parent->Scripts.Add(this);
+                    Level::ScenesLock.Unlock();
                 }
             }
             else if (!parent && parentId.IsValid())
@@ -22,6 +22,7 @@
 #include "ManagedCLR/MException.h"
 #include "Internal/StdTypesContainer.h"
 #include "Engine/Core/ObjectsRemovalService.h"
+#include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Core/Types/Stopwatch.h"
 #include "Engine/Content/Asset.h"
@@ -57,7 +58,6 @@ namespace
 {
     MDomain* _rootDomain = nullptr;
     MDomain* _scriptsDomain = nullptr;
-    CriticalSection _objectsLocker;
 #define USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING 0
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     struct ScriptingObjectData
@@ -93,10 +93,97 @@ namespace
         }
     };
 
-    Dictionary<Guid, ScriptingObjectData> _objectsDictionary(1024 * 16);
+    typedef ScriptingObjectData ScriptingObjectEntry;
 #else
-    Dictionary<Guid, ScriptingObject*> _objectsDictionary(1024 * 16);
+    typedef ScriptingObject* ScriptingObjectEntry;
 #endif
+
+    // Objects registry is split into shards (picked by the object id hash) with separate locks so lookups from multiple threads don't contend on a single lock
+#define SCRIPTING_OBJECTS_SHARDS_BITS 5
+#define SCRIPTING_OBJECTS_SHARDS (1 << SCRIPTING_OBJECTS_SHARDS_BITS)
+    struct ObjectsShard
+    {
+        CriticalSection Locker;
+        Dictionary<Guid, ScriptingObjectEntry> Objects;
+        // Registered objects of each type (used when searching objects by type)
+        Dictionary<ScriptingTypeHandle, HashSet<ScriptingObject*>> Types;
+
+        ObjectsShard()
+            : Objects(1024 * 16 / SCRIPTING_OBJECTS_SHARDS)
+        {
+        }
+
+        void Add(const Guid& id, ScriptingObject* obj)
+        {
+            Objects.Add(id, obj);
+            Types[obj->GetTypeHandle()].Add(obj);
+        }
+
+        void Remove(const Guid& id)
+        {
+            const auto it = Objects.Find(id);
+            if (it.IsEnd())
+                return;
+            ScriptingObject* obj = it->Value;
+            const auto typeIt = Types.Find(obj->GetTypeHandle());
+            if (typeIt.IsNotEnd())
+            {
+                // Remove empty sets so types from the unloaded modules don't stay in the index
+                typeIt->Value.Remove(obj);
+                if (typeIt->Value.IsEmpty())
+                    Types.Remove(typeIt);
+            }
+            Objects.Remove(it);
+        }
+    };
+
+    ObjectsShard _objectsShards[SCRIPTING_OBJECTS_SHARDS];
+
+    FORCE_INLINE int32 GetObjectsShardIndex(const Guid& id)
+    {
+        // Use the high bits of the scrambled hash (dictionary buckets use the low bits of the id hash)
+        return (int32)((GetHash(id) * 2654435761u) >> (32 - SCRIPTING_OBJECTS_SHARDS_BITS));
+    }
+
+    FORCE_INLINE ObjectsShard& GetObjectsShard(const Guid& id)
+    {
+        return _objectsShards[GetObjectsShardIndex(id)];
+    }
+
+    ScriptingObject* GetObject(const Guid& id)
+    {
+        ObjectsShard& shard = GetObjectsShard(id);
+        shard.Locker.Lock();
+        const auto it = shard.Objects.Find(id);
+        ScriptingObject* result = it.IsNotEnd() ? (ScriptingObject*)it->Value : nullptr;
+        shard.Locker.Unlock();
+        return result;
+    }
+
+    void DisposeObjects(const BinaryModule* skipModule)
+    {
+        // Dispose can unregister or change id of the other objects (which locks the other shards) so call it without holding the shard lock
+        Array<Guid> ids;
+        for (ObjectsShard& shard : _objectsShards)
+        {
+            shard.Locker.Lock();
+            ids.Clear();
+            for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
+                ids.Add(i->Key);
+            shard.Locker.Unlock();
+            for (const Guid& id : ids)
+            {
+                // Skip objects released by the other objects disposal
+                ScriptingObject* obj = GetObject(id);
+                if (!obj || obj->GetTypeHandle().Module == skipModule)
+                    continue;
+#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
+                LOG(Info, "[OnScriptingDispose] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
+#endif
+                obj->OnScriptingDispose();
+            }
+        }
+    }
     bool _isEngineAssemblyLoaded = false;
     bool _hasGameModulesLoaded = false;
     MMethod* _method_Update = nullptr;
@@ -574,18 +661,7 @@ void Scripting::Release()
     MCore::GC::WaitForPendingFinalizers();
 
     // Release managed objects instances for persistent objects (assets etc.)
-    _objectsLocker.Lock();
-    {
-        for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
-        {
-            auto obj = i->Value;
-#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-            LOG(Info, "[OnScriptingDispose] obj = 0x{0:x}, {1}", (uint64)obj.Ptr, String(obj.TypeName));
-#endif
-            obj->OnScriptingDispose();
-        }
-    }
-    _objectsLocker.Unlock();
+    DisposeObjects(nullptr);
 
     // Release assets sourced from game assemblies
     const auto flaxModule = GetBinaryModuleFlaxEngine();
@@ -682,21 +758,7 @@ void Scripting::Reload(bool canTriggerSceneReload)
 
     // Destroy objects from game assemblies (eg. not released objects that might crash if persist in memory after reload)
     const auto flaxModule = GetBinaryModuleFlaxEngine();
-    _objectsLocker.Lock();
-    {
-        for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
-        {
-            auto obj = i->Value;
-            if (obj->GetTypeHandle().Module == flaxModule)
-                continue;
-
-#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-            LOG(Info, "[OnScriptingDispose] obj = 0x{0:x}, {1}", (uint64)obj.Ptr, String(obj.TypeName));
-#endif
-            obj->OnScriptingDispose();
-        }
-    }
-    _objectsLocker.Unlock();
+    DisposeObjects(flaxModule);
 
     // Release assets sourced from game assemblies
     for (auto asset : Content::GetAssets())
@@ -874,18 +936,7 @@ ScriptingObject* Scripting::FindObject(Guid id, MClass* type)
     }
 
     // Try to find it
-#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-    ScriptingObjectData data;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, data);
-    _objectsLocker.Unlock();
-    auto result = data.Ptr;
-#else
-    ScriptingObject* result = nullptr;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, result);
-    _objectsLocker.Unlock();
-#endif
+    ScriptingObject* result = GetObject(id);
     if (result)
     {
         // Check type
@@ -928,18 +979,7 @@ ScriptingObject* Scripting::TryFindObject(Guid id, MClass* type)
     }
 
     // Try to find it
-#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-    ScriptingObjectData data;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, data);
-    _objectsLocker.Unlock();
-    auto result = data.Ptr;
-#else
-    ScriptingObject* result = nullptr;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, result);
-    _objectsLocker.Unlock();
-#endif
+    ScriptingObject* result = GetObject(id);
 
     // Check type
     if (result && type && !result->Is(type))
@@ -954,12 +994,18 @@ ScriptingObject* Scripting::TryFindObject(MClass* type)
 {
     if (type == nullptr)
         return nullptr;
-    ScopeLock lock(_objectsLocker);
-    for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+    for (ObjectsShard& shard : _objectsShards)
     {
-        const auto obj = i->Value;
-        if (obj->GetClass() == type)
-            return obj;
+        ScopeLock lock(shard.Locker);
+        for (auto i = shard.Types.Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Key.GetType().ManagedClass == type)
+            {
+                auto it = i->Value.Begin();
+                if (it.IsNotEnd())
+                    return it->Item;
+            }
+        }
     }
     return nullptr;
 }
@@ -970,16 +1016,18 @@ ScriptingObject* Scripting::FindObject(const MObject* managedInstance)
         return nullptr;
     PROFILE_CPU();
 
-    // TODO: optimize it by reading the unmanagedPtr or _internalId from managed Object property
-
-    ScopeLock lock(_objectsLocker);
-
-    for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
-    {
-        const auto obj = i->Value;
-        if (obj->GetManagedInstance() == managedInstance)
-            return obj;
-    }
+    // Get the native object from the managed object and validate it's still registered
+    ScriptingObject* obj = nullptr;
+    if (MCore::Object::GetClass((MObject*)managedInstance)->IsSubClassOf(ScriptingObject::GetStaticClass()))
+        obj = ScriptingObject::ToNative((MObject*)managedInstance);
+    if (obj == nullptr)
+        return nullptr;
+    const Guid id = obj->GetID();
+    ObjectsShard& shard = GetObjectsShard(id);
+    ScopeLock lock(shard.Locker);
+    const auto it = shard.Objects.Find(id);
+    if (it.IsNotEnd() && (ScriptingObject*)it->Value == obj && obj->GetManagedInstance() == managedInstance)
+        return obj;
     return nullptr;
 }
 
@@ -989,19 +1037,19 @@ void Scripting::OnManagedInstanceDeleted(ScriptingObject* obj)
     ASSERT(obj);
 
     // Validate if object still exists
-    _objectsLocker.Lock();
-    if (_objectsDictionary.ContainsValue(obj))
+    for (ObjectsShard& shard : _objectsShards)
     {
+        ScopeLock lock(shard.Locker);
+        if (shard.Objects.ContainsValue(obj))
+        {
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-        LOG(Info, "[OnManagedInstanceDeleted] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
+            LOG(Info, "[OnManagedInstanceDeleted] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-        obj->OnManagedInstanceDeleted();
-    }
-    else
-    {
-        //LOG(Warning, "Object finalization called for already removed object (address={0:x})", (uint64)obj);
+            obj->OnManagedInstanceDeleted();
+            return;
+        }
     }
-    _objectsLocker.Unlock();
+    //LOG(Warning, "Object finalization called for already removed object (address={0:x})", (uint64)obj);
 }
 
 bool Scripting::HasGameModulesLoaded()
@@ -1029,16 +1077,17 @@ bool Scripting::IsTypeFromGameScripts(MClass* type)
 void Scripting::RegisterObject(ScriptingObject* obj)
 {
     const Guid id = obj->GetID();
-    ScopeLock lock(_objectsLocker);
+    ObjectsShard& shard = GetObjectsShard(id);
+    ScopeLock lock(shard.Locker);
 
-    //ASSERT(!_objectsDictionary.ContainsValue(obj));
+    //ASSERT(!shard.Objects.ContainsValue(obj));
 #if ENABLE_ASSERTION
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     ScriptingObjectData other;
-    if (_objectsDictionary.TryGet(id, other))
+    if (shard.Objects.TryGet(id, other))
 #else
     ScriptingObject* other;
-    if (_objectsDictionary.TryGet(id, other))
+    if (shard.Objects.TryGet(id, other))
 #endif
     {
         // Something went wrong...
@@ -1049,33 +1098,46 @@ void Scripting::RegisterObject(ScriptingObject* obj)
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     LOG(Info, "[RegisterObject] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-    _objectsDictionary[id] = obj;
+    shard.Remove(id);
+    shard.Add(id, obj);
 }
 
 void Scripting::UnregisterObject(ScriptingObject* obj)
 {
-    ScopeLock lock(_objectsLocker);
+    const Guid id = obj->GetID();
+    ObjectsShard& shard = GetObjectsShard(id);
+    ScopeLock lock(shard.Locker);
 
-    //ASSERT(!obj->_id.IsValid() || _objectsDictionary.ContainsValue(obj));
+    //ASSERT(!obj->_id.IsValid() || shard.Objects.ContainsValue(obj));
 
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     LOG(Info, "[UnregisterObject] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-    _objectsDictionary.Remove(obj->GetID());
+    shard.Remove(id);
 }
 
 void Scripting::OnObjectIdChanged(ScriptingObject* obj, const Guid& oldId)
 {
-    ScopeLock lock(_objectsLocker);
-
     ASSERT(obj && oldId.IsValid());
     ASSERT(obj->GetID() != oldId);
-    ASSERT(_objectsDictionary.ContainsKey(oldId));
-    //ASSERT(_objectsDictionary.ContainsValue(obj));
-    ASSERT(!_objectsDictionary.ContainsKey(obj->GetID()));
 
-    _objectsDictionary.Remove(oldId);
-    _objectsDictionary.Add(obj->GetID(), obj);
+    // Lock both shards (in the same order to prevent deadlocks)
+    const int32 oldShardIndex = GetObjectsShardIndex(oldId);
+    const int32 newShardIndex = GetObjectsShardIndex(obj->GetID());
+    ObjectsShard& oldShard = _objectsShards[oldShardIndex];
+    ObjectsShard& newShard = _objectsShards[newShardIndex];
+    _objectsShards[Math::Min(oldShardIndex, newShardIndex)].Locker.Lock();
+    _objectsShards[Math::Max(oldShardIndex, newShardIndex)].Locker.Lock();
+
+    ASSERT(oldShard.Objects.ContainsKey(oldId));
+    //ASSERT(oldShard.Objects.ContainsValue(obj));
+    ASSERT(!newShard.Objects.ContainsKey(obj->GetID()));
+
+    oldShard.Remove(oldId);
+    newShard.Add(obj->GetID(), obj);
+
+    _objectsShards[Math::Max(oldShardIndex, newShardIndex)].Locker.Unlock();
+    _objectsShards[Math::Min(oldShardIndex, newShardIndex)].Locker.Unlock();
 }
 
 bool initFlaxEngine()
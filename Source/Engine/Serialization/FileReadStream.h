@@ -40,6 +40,14 @@ class FLAXENGINE_API FileReadStream : public ReadStream
         return _file;
     }
 
+    /// <summary>
+    /// Gets the file handle.
+    /// </summary>
+    FORCE_INLINE File* GetFile()
+    {
+        return _file;
+    }
+
     /// <summary>
     /// Unlink file object passed via constructor
     /// </summary>
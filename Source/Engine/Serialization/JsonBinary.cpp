@@ -0,0 +1,348 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "JsonBinary.h"
+#include "ReadStream.h"
+#include "WriteStream.h"
+#include "MemoryWriteStream.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// Binary json data header (magic is 'BJSN' so it never collides with the json text that starts with whitespace or a bracket)
+#define JSON_BINARY_MAGIC 0x4E534A42
+#define JSON_BINARY_VERSION 1
+
+namespace
+{
+    enum class JsonBinaryTag : byte
+    {
+        Null,
+        False,
+        True,
+        Int,
+        Uint,
+        Int64,
+        Uint64,
+        Double,
+        String,
+        Array,
+        Object,
+    };
+
+    struct JsonBinaryWriter
+    {
+        MemoryWriteStream Values;
+        Array<StringAnsiView> Strings;
+        Dictionary<StringAnsiView, int32> StringsLookup;
+
+        JsonBinaryWriter()
+            : Values(4 * 1024)
+        {
+        }
+
+        int32 GetString(const char* str, int32 length)
+        {
+            const StringAnsiView view(str, length);
+            const int32* index = StringsLookup.TryGet(view);
+            if (index)
+                return *index;
+            const int32 result = Strings.Count();
+            Strings.Add(view);
+            StringsLookup.Add(view, result);
+            return result;
+        }
+
+        void Write(const rapidjson_flax::Value& value)
+        {
+            switch (value.GetType())
+            {
+            case rapidjson::kNullType:
+                Values.WriteByte((byte)JsonBinaryTag::Null);
+                break;
+            case rapidjson::kFalseType:
+                Values.WriteByte((byte)JsonBinaryTag::False);
+                break;
+            case rapidjson::kTrueType:
+                Values.WriteByte((byte)JsonBinaryTag::True);
+                break;
+            case rapidjson::kNumberType:
+                if (value.IsInt())
+                {
+                    Values.WriteByte((byte)JsonBinaryTag::Int);
+                    Values.WriteInt32(value.GetInt());
+                }
+                else if (value.IsUint())
+                {
+                    Values.WriteByte((byte)JsonBinaryTag::Uint);
+                    Values.WriteUint32(value.GetUint());
+                }
+                else if (value.IsInt64())
+                {
+                    Values.WriteByte((byte)JsonBinaryTag::Int64);
+                    Values.WriteInt64(value.GetInt64());
+                }
+                else if (value.IsUint64())
+                {
+                    Values.WriteByte((byte)JsonBinaryTag::Uint64);
+                    Values.WriteUint64(value.GetUint64());
+                }
+                else
+                {
+                    Values.WriteByte((byte)JsonBinaryTag::Double);
+                    Values.WriteDouble(value.GetDouble());
+                }
+                break;
+            case rapidjson::kStringType:
+                Values.WriteByte((byte)JsonBinaryTag::String);
+                Values.WriteInt32(GetString(value.GetString(), (int32)value.GetStringLength()));
+                break;
+            case rapidjson::kArrayType:
+                Values.WriteByte((byte)JsonBinaryTag::Array);
+                Values.WriteInt32((int32)value.Size());
+                for (auto i = value.Begin(); i != value.End(); ++i)
+                    Write(*i);
+                break;
+            case rapidjson::kObjectType:
+                Values.WriteByte((byte)JsonBinaryTag::Object);
+                Values.WriteInt32((int32)value.MemberCount());
+                for (auto i = value.MemberBegin(); i != value.MemberEnd(); ++i)
+                {
+                    Values.WriteInt32(GetString(i->name.GetString(), (int32)i->name.GetStringLength()));
+                    Write(i->value);
+                }
+                break;
+            }
+        }
+    };
+
+    struct JsonBinaryReader
+    {
+        ReadStream& Stream;
+        uint32 Length;
+        Array<const char*> Strings;
+        Array<int32> StringsLengths;
+        bool Failed = false;
+
+        JsonBinaryReader(ReadStream& stream)
+            : Stream(stream)
+            , Length(stream.GetLength())
+        {
+        }
+
+        FORCE_INLINE bool CanRead(uint64 size)
+        {
+            return (uint64)Stream.GetPosition() + size <= Length;
+        }
+
+        FORCE_INLINE bool ReadIndex(int32& index)
+        {
+            if (!CanRead(sizeof(int32)))
+                return false;
+            Stream.ReadInt32(&index);
+            return (uint32)index < (uint32)Strings.Count();
+        }
+
+        bool ReadValue(rapidjson_flax::Document& handler)
+        {
+            if (!CanRead(sizeof(byte)))
+                return false;
+            switch ((JsonBinaryTag)Stream.ReadByte())
+            {
+            case JsonBinaryTag::Null:
+                return handler.Null();
+            case JsonBinaryTag::False:
+                return handler.Bool(false);
+            case JsonBinaryTag::True:
+                return handler.Bool(true);
+            case JsonBinaryTag::Int:
+            {
+                int32 value;
+                if (!CanRead(sizeof(value)))
+                    return false;
+                Stream.ReadInt32(&value);
+                return handler.Int(value);
+            }
+            case JsonBinaryTag::Uint:
+            {
+                uint32 value;
+                if (!CanRead(sizeof(value)))
+                    return false;
+                Stream.ReadUint32(&value);
+                return handler.Uint(value);
+            }
+            case JsonBinaryTag::Int64:
+            {
+                int64 value;
+                if (!CanRead(sizeof(value)))
+                    return false;
+                Stream.ReadInt64(&value);
+                return handler.Int64(value);
+            }
+            case JsonBinaryTag::Uint64:
+            {
+                uint64 value;
+                if (!CanRead(sizeof(value)))
+                    return false;
+                Stream.ReadUint64(&value);
+                return handler.Uint64(value);
+            }
+            case JsonBinaryTag::Double:
+            {
+                double value;
+                if (!CanRead(sizeof(value)))
+                    return false;
+                Stream.ReadDouble(&value);
+                return handler.Double(value);
+            }
+            case JsonBinaryTag::String:
+            {
+                int32 index;
+                if (!ReadIndex(index))
+                    return false;
+
+                // Reference the strings table owned by the document allocator (no copy)
+                return handler.String(Strings.Get()[index], StringsLengths.Get()[index], false);
+            }
+            case JsonBinaryTag::Array:
+            {
+                int32 count;
+                if (!CanRead(sizeof(count)))
+                    return false;
+                Stream.ReadInt32(&count);
+                if (count < 0 || !CanRead(count) || !handler.StartArray())
+                    return false;
+                for (int32 i = 0; i < count; i++)
+                {
+                    if (!ReadValue(handler))
+                        return false;
+                }
+                return handler.EndArray(count);
+            }
+            case JsonBinaryTag::Object:
+            {
+                int32 count;
+                if (!CanRead(sizeof(count)))
+                    return false;
+                Stream.ReadInt32(&count);
+                if (count < 0 || !CanRead((uint64)count * 5) || !handler.StartObject())
+                    return false;
+                for (int32 i = 0; i < count; i++)
+                {
+                    int32 index;
+                    if (!ReadIndex(index) || !handler.Key(Strings.Get()[index], StringsLengths.Get()[index], false) || !ReadValue(handler))
+                        return false;
+                }
+                return handler.EndObject(count);
+            }
+            default:
+                return false;
+            }
+        }
+
+        bool operator()(rapidjson_flax::Document& handler)
+        {
+            Failed = !ReadValue(handler);
+            return !Failed;
+        }
+    };
+}
+
+bool JsonBinary::IsBinary(const byte* data, int32 length)
+{
+    if (length < (int32)(sizeof(uint32) + sizeof(int32)))
+        return false;
+    uint32 magic;
+    Platform::MemoryCopy(&magic, data, sizeof(magic));
+    return magic == JSON_BINARY_MAGIC;
+}
+
+void JsonBinary::Write(WriteStream& stream, const rapidjson_flax::Value& value)
+{
+    PROFILE_CPU();
+    JsonBinaryWriter writer;
+    writer.Write(value);
+
+    // Header
+    stream.WriteUint32(JSON_BINARY_MAGIC);
+    stream.WriteInt32(JSON_BINARY_VERSION);
+
+    // Strings table (null-terminated strings stored one after another)
+    int32 stringsSize = 0;
+    for (const StringAnsiView& str : writer.Strings)
+        stringsSize += str.Length() + 1;
+    stream.WriteInt32(writer.Strings.Count());
+    stream.WriteInt32(stringsSize);
+    for (const StringAnsiView& str : writer.Strings)
+        stream.WriteInt32(str.Length());
+    for (const StringAnsiView& str : writer.Strings)
+    {
+        stream.WriteBytes(str.Get(), str.Length());
+        stream.WriteByte(0);
+    }
+
+    // Values tree
+    stream.WriteBytes(writer.Values.GetHandle(), writer.Values.GetPosition());
+}
+
+bool JsonBinary::Read(ReadStream& stream, rapidjson_flax::Document& document)
+{
+    PROFILE_CPU();
+    JsonBinaryReader reader(stream);
+
+    // Header
+    uint32 magic = 0;
+    int32 version = 0, stringsCount = 0, stringsSize = 0;
+    if (!reader.CanRead(sizeof(uint32) + sizeof(int32) * 3))
+    {
+        LOG(Warning, "Invalid binary json data.");
+        return true;
+    }
+    stream.ReadUint32(&magic);
+    stream.ReadInt32(&version);
+    stream.ReadInt32(&stringsCount);
+    stream.ReadInt32(&stringsSize);
+    if (magic != JSON_BINARY_MAGIC || version != JSON_BINARY_VERSION)
+    {
+        LOG(Warning, "Unsupported binary json data version.");
+        return true;
+    }
+    if (stringsCount < 0 || stringsSize < stringsCount || !reader.CanRead(stringsCount * sizeof(int32)))
+    {
+        LOG(Warning, "Invalid binary json data.");
+        return true;
+    }
+
+    // Strings table (allocated by the document so it lives as long as the values that reference it)
+    reader.StringsLengths.Resize(stringsCount);
+    stream.ReadBytes(reader.StringsLengths.Get(), stringsCount * sizeof(int32));
+    if (!reader.CanRead(stringsSize))
+    {
+        LOG(Warning, "Invalid binary json data.");
+        return true;
+    }
+    char* strings = stringsSize != 0 ? (char*)document.GetAllocator().Malloc(stringsSize) : nullptr;
+    stream.ReadBytes(strings, stringsSize);
+    reader.Strings.Resize(stringsCount);
+    int32 offset = 0;
+    for (int32 i = 0; i < stringsCount; i++)
+    {
+        const int32 length = reader.StringsLengths.Get()[i];
+        if (length < 0 || offset + length >= stringsSize || strings[offset + length] != 0)
+        {
+            LOG(Warning, "Invalid binary json data.");
+            return true;
+        }
+        reader.Strings.Get()[i] = strings + offset;
+        offset += length + 1;
+    }
+
+    // Values tree
+    document.Populate(reader);
+    if (reader.Failed)
+    {
+        LOG(Warning, "Invalid binary json data.");
+        return true;
+    }
+    return false;
+}
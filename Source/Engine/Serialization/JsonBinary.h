@@ -0,0 +1,39 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Json.h"
+
+class ReadStream;
+class WriteStream;
+
+/// <summary>
+/// Binary format of the json documents used by the cooked scenes and prefabs. All strings (members names, objects ids, type names, etc.) are stored once in the strings table and the values tree is stored as tagged binary data with the amount of members and items known upfront.
+/// Loading it doesn't involve any text parsing and the document strings reference the strings table without copying them.
+/// </summary>
+class FLAXENGINE_API JsonBinary
+{
+public:
+    /// <summary>
+    /// Checks if the data is in the binary json format (otherwise it's a json text).
+    /// </summary>
+    /// <param name="data">The data.</param>
+    /// <param name="length">The data length (in bytes).</param>
+    /// <returns>True if data is in binary json format, otherwise false.</returns>
+    static bool IsBinary(const byte* data, int32 length);
+
+    /// <summary>
+    /// Writes the json value in the binary format.
+    /// </summary>
+    /// <param name="stream">The output stream.</param>
+    /// <param name="value">The json value to write.</param>
+    static void Write(WriteStream& stream, const rapidjson_flax::Value& value);
+
+    /// <summary>
+    /// Reads the json document from the binary format.
+    /// </summary>
+    /// <param name="stream">The input stream.</param>
+    /// <param name="document">The output document.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool Read(ReadStream& stream, rapidjson_flax::Document& document);
+};
@@ -23,6 +23,17 @@ class FLAXENGINE_API IStreamingHandler
     /// <returns>Target quality (0-1).</returns>
     virtual float CalculateTargetQuality(StreamableResource* resource, double currentTime) = 0;
 
+    /// <summary>
+    /// Calculates the screen impact (0-1) of the given resource. Used together with the target quality to rank resources when streaming is over the memory budget (resources with the lowest value get evicted first).
+    /// </summary>
+    /// <param name="resource">The resource.</param>
+    /// <param name="currentTime">The current platform time (seconds).</param>
+    /// <returns>Screen impact (0-1).</returns>
+    virtual float CalculateScreenImpact(StreamableResource* resource, double currentTime)
+    {
+        return 1.0f;
+    }
+
     /// <summary>
     /// Calculates the residency level for a given resource and quality level.
     /// </summary>
@@ -79,6 +79,15 @@ class FLAXENGINE_API StreamableResource
     /// </summary>
     virtual int32 GetAllocatedResidency() const = 0;
 
+    /// <summary>
+    /// Gets the memory size of the resource data at the given residency level (in bytes). Used by the streaming memory budgets. Returns 0 if resource doesn't support it (ignored by the budgets).
+    /// </summary>
+    /// <param name="residency">The residency level.</param>
+    virtual uint64 GetResidencyMemoryUsage(int32 residency) const
+    {
+        return 0;
+    }
+
 public:
 
     /// <summary>
@@ -113,6 +122,9 @@ class FLAXENGINE_API StreamableResource
         double LastUpdateTime = 0.0;
         double TargetResidencyChangeTime = 0;
         int32 TargetResidency = 0;
+        int32 DesiredResidency = 0;
+        int32 ResidencyLimit = MAX_int32;
+        float TargetQuality = 0.0f;
         bool Error = false;
         SamplesBuffer<float, 5> QualitySamples;
     };
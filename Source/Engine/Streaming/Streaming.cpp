@@ -6,6 +6,7 @@
 #include "StreamingSettings.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/TaskGraph.h"
@@ -21,6 +22,25 @@ namespace StreamingManagerImpl
     Array<StreamableResource*> Resources;
     Array<GPUSampler*, InlinedAllocation<32>> TextureGroupSamplers;
     GPUSampler* FallbackSampler = nullptr;
+    double LastBudgetUpdateTime = 0.0;
+    StreamingStats BudgetStats;
+
+    struct BudgetItem
+    {
+        int32 ResourceIndex;
+        int32 Residency;
+        float Value;
+        uint64 Memory;
+
+        bool operator<(const BudgetItem& other) const
+        {
+            // Evict the lowest value first (higher residency levels of the same resource always go before the lower ones)
+            return Value < other.Value || (Value == other.Value && Residency > other.Residency);
+        }
+    };
+
+    Array<BudgetItem> BudgetItems;
+    Array<int32> BudgetLimits;
 }
 
 using namespace StreamingManagerImpl;
@@ -52,10 +72,16 @@ namespace
 StreamingService StreamingServiceInstance;
 
 Array<TextureGroup, InlinedAllocation<32>> Streaming::TextureGroups;
+uint64 Streaming::MemoryBudget = 0;
 
 void StreamingSettings::Apply()
 {
     Streaming::TextureGroups = TextureGroups;
+    Streaming::MemoryBudget = (uint64)MemoryBudget * 1024 * 1024;
+    const auto groups = StreamingGroups::Instance();
+    groups->Textures()->MemoryBudget = (uint64)TexturesMemoryBudget * 1024 * 1024;
+    groups->Models()->MemoryBudget = (uint64)ModelsMemoryBudget * 1024 * 1024;
+    groups->SkinnedModels()->MemoryBudget = (uint64)SkinnedModelsMemoryBudget * 1024 * 1024;
     SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
     TextureGroupSamplers.Resize(TextureGroups.Count(), false);
 }
@@ -63,6 +89,10 @@ void StreamingSettings::Apply()
 void StreamingSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
 {
     DESERIALIZE(TextureGroups);
+    DESERIALIZE(MemoryBudget);
+    DESERIALIZE(TexturesMemoryBudget);
+    DESERIALIZE(ModelsMemoryBudget);
+    DESERIALIZE(SkinnedModelsMemoryBudget);
 }
 
 StreamableResource::StreamableResource(StreamingGroup* group)
@@ -135,6 +165,7 @@ void UpdateResource(StreamableResource* resource, double currentTime)
     resource->Streaming.QualitySamples.Add(targetQuality);
     targetQuality = resource->Streaming.QualitySamples.Maximum();
     targetQuality = Math::Saturate(targetQuality);
+    resource->Streaming.TargetQuality = targetQuality;
 
     // Calculate target residency level (discrete value)
     auto maxResidency = resource->GetMaxResidency();
@@ -142,6 +173,10 @@ void UpdateResource(StreamableResource* resource, double currentTime)
     auto allocatedResidency = resource->GetAllocatedResidency();
     auto targetResidency = handler->CalculateResidency(resource, targetQuality);
     ASSERT(allocatedResidency >= currentResidency && allocatedResidency >= 0);
+    resource->Streaming.DesiredResidency = targetResidency;
+
+    // Apply the memory budgets limit (see UpdateBudgets)
+    targetResidency = Math::Min(targetResidency, resource->Streaming.ResidencyLimit);
     resource->Streaming.LastUpdateTime = currentTime;
 
     // Check if a target residency level has been changed
@@ -188,25 +223,123 @@ void UpdateResource(StreamableResource* resource, double currentTime)
     else
     {
         // TODO: Check if target residency is stable (no changes for a while)
+    }
+}
+
+void UpdateBudgets(double currentTime)
+{
+    PROFILE_CPU();
+    const auto& groups = StreamingGroups::Instance()->Groups();
+    Array<uint64, InlinedAllocation<8>> groupsRequested;
+    groupsRequested.Resize(groups.Count());
+    groupsRequested.SetAll(0);
+
+    // Sum the memory used by the resources and the memory they would use at the target quality
+    uint64 memoryUsage = 0, memoryRequested = 0;
+    for (int32 i = 0; i < Resources.Count(); i++)
+    {
+        StreamableResource* resource = Resources.Get()[i];
+        const uint64 requested = resource->GetResidencyMemoryUsage(resource->Streaming.DesiredResidency);
+        memoryUsage += resource->GetResidencyMemoryUsage(resource->GetAllocatedResidency());
+        memoryRequested += requested;
+        const int32 groupIndex = groups.Find(resource->GetGroup());
+        if (groupIndex != -1)
+            groupsRequested[groupIndex] += requested;
+    }
+
+    // Find the most exceeded budget
+    float pressure = 0.0f;
+    if (Streaming::MemoryBudget != 0)
+        pressure = (float)((double)memoryRequested / (double)Streaming::MemoryBudget);
+    for (int32 groupIndex = 0; groupIndex < groups.Count(); groupIndex++)
+    {
+        if (groups[groupIndex]->MemoryBudget != 0)
+            pressure = Math::Max(pressure, (float)((double)groupsRequested[groupIndex] / (double)groups[groupIndex]->MemoryBudget));
+    }
+
+    // Start from the desired residency of all resources
+    BudgetLimits.Resize(Resources.Count(), false);
+    for (int32 i = 0; i < Resources.Count(); i++)
+        BudgetLimits[i] = MAX_int32;
+    if (pressure > 1.0f)
+    {
+        // Rank all the residency levels that can be evicted by the resource value (quality and screen impact) per byte so large mips/LODs of unimportant resources go first
+        const float MinQuality = 0.01f;
+        BudgetItems.Clear();
+        for (int32 i = 0; i < Resources.Count(); i++)
+        {
+            StreamableResource* resource = Resources.Get()[i];
+            const int32 desiredResidency = resource->Streaming.DesiredResidency;
+            if (!resource->CanBeUpdated() || resource->GetResidencyMemoryUsage(desiredResidency) == 0)
+                continue;
+            IStreamingHandler* handler = resource->GetGroup()->GetHandler();
+            const int32 minResidency = Math::Min(handler->CalculateResidency(resource, MinQuality), desiredResidency);
+            const float priority = Math::Max(resource->Streaming.TargetQuality * handler->CalculateScreenImpact(resource, currentTime), ZeroTolerance);
+            BudgetLimits[i] = desiredResidency;
+            uint64 memory = resource->GetResidencyMemoryUsage(desiredResidency);
+            for (int32 residency = desiredResidency; residency > minResidency; residency--)
+            {
+                const uint64 memoryBelow = resource->GetResidencyMemoryUsage(residency - 1);
+                auto& item = BudgetItems.AddOne();
+                item.ResourceIndex = i;
+                item.Residency = residency;
+                item.Value = priority / (float)Math::Max<uint64>(memory, 1);
+                item.Memory = memory - Math::Min(memoryBelow, memory);
+                memory = memoryBelow;
+            }
+        }
+        Sorting::QuickSort(BudgetItems);
 
-        // TODO: deallocate or decrease memory usage after timeout? (timeout should be smaller on low mem)
+        // Evict the lowest value levels until all budgets are met
+        uint64 globalRequested = memoryRequested;
+        for (const BudgetItem& item : BudgetItems)
+        {
+            StreamableResource* resource = Resources.Get()[item.ResourceIndex];
+            const int32 groupIndex = groups.Find(resource->GetGroup());
+            const bool overGlobal = Streaming::MemoryBudget != 0 && globalRequested > Streaming::MemoryBudget;
+            bool overAny = overGlobal;
+            for (int32 j = 0; j < groups.Count() && !overAny; j++)
+                overAny = groups[j]->MemoryBudget != 0 && groupsRequested[j] > groups[j]->MemoryBudget;
+            if (!overAny)
+                break;
+            const bool overGroup = groupIndex != -1 && groups[groupIndex]->MemoryBudget != 0 && groupsRequested[groupIndex] > groups[groupIndex]->MemoryBudget;
+            if ((!overGlobal && !overGroup) || BudgetLimits[item.ResourceIndex] != item.Residency)
+                continue;
+            BudgetLimits[item.ResourceIndex] = item.Residency - 1;
+            globalRequested -= item.Memory;
+            if (groupIndex != -1)
+                groupsRequested[groupIndex] -= item.Memory;
+        }
     }
 
-    // low memory case:
-    // if we are on budget and cannot load everything we have to:
-    // decrease global resources quality scale (per resources group)
-    // decrease asset deallocate timeout
+    // Apply the limits (resources with the changed limit get updated as soon as possible)
+    int32 evictedCount = 0;
+    for (int32 i = 0; i < Resources.Count(); i++)
+    {
+        StreamableResource* resource = Resources.Get()[i];
+        int32 limit = BudgetLimits[i];
+        if (limit >= resource->Streaming.DesiredResidency)
+            limit = MAX_int32;
+        else
+            evictedCount++;
+        if (resource->Streaming.ResidencyLimit != limit)
+        {
+            resource->Streaming.ResidencyLimit = limit;
+            resource->RequestStreamingUpdate();
+        }
+    }
 
-    // low mem detecting:
-    // for low mem we have to get whole memory budget for a group and then
-    // subtract immutable resources mem usage (like render targets or non dynamic resources)
-    // so we get amount of memory we can distribute and we can detect if we are out of the limit
-    // low mem should be updated once per a few frames
+    BudgetStats.MemoryUsage = memoryUsage;
+    BudgetStats.MemoryRequested = memoryRequested;
+    BudgetStats.MemoryBudget = Streaming::MemoryBudget;
+    BudgetStats.MemoryPressure = pressure;
+    BudgetStats.EvictedResourcesCount = evictedCount;
 }
 
 bool StreamingService::Init()
 {
     System = New<StreamingSystem>();
+    System->AsyncExecute = true;
     Engine::UpdateGraph->AddSystem(System);
     return false;
 }
@@ -225,6 +358,7 @@ void StreamingSystem::Job(int32 index)
 
     // TODO: use streaming settings
     const double ResourceUpdatesInterval = 0.1;
+    const double BudgetUpdateInterval = 0.5;
     int32 MaxResourcesPerUpdate = 50;
 
     // Start update
@@ -233,6 +367,13 @@ void StreamingSystem::Job(int32 index)
     int32 resourcesUpdates = Math::Min(MaxResourcesPerUpdate, resourcesCount);
     const double currentTime = Platform::GetTimeSeconds();
 
+    // Update memory budgets (limits the resources residency)
+    if (currentTime - LastBudgetUpdateTime >= BudgetUpdateInterval)
+    {
+        LastBudgetUpdateTime = currentTime;
+        UpdateBudgets(currentTime);
+    }
+
     // Update high priority queue and then rest of the resources
     // Note: resources in the update queue are updated always, while others only between specified intervals
     int32 resourcesChecks = resourcesCount;
@@ -272,6 +413,7 @@ StreamingStats Streaming::GetStats()
 {
     StreamingStats stats;
     ResourcesLock.Lock();
+    stats = BudgetStats;
     stats.ResourcesCount = Resources.Count();
     for (auto e : Resources)
     {
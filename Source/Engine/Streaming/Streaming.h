@@ -16,6 +16,16 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingStats);
     API_FIELD() int32 ResourcesCount = 0;
     // Amount of resources that are during streaming in (target residency is higher that the current). Zero if all resources are streamed in.
     API_FIELD() int32 StreamingResourcesCount = 0;
+    // Memory used by the streamed resources that support memory budgets (in bytes).
+    API_FIELD() uint64 MemoryUsage = 0;
+    // Memory that the streamed resources would use at their target quality without the budget limits (in bytes).
+    API_FIELD() uint64 MemoryRequested = 0;
+    // The global memory budget for the streamed resources (in bytes). Zero if unlimited.
+    API_FIELD() uint64 MemoryBudget = 0;
+    // The memory pressure: ratio of the requested memory to the most exceeded budget (global or per-group). Values above 1 mean that resources are evicted to fit into the budget.
+    API_FIELD() float MemoryPressure = 0.0f;
+    // Amount of resources that have their quality decreased to fit into the memory budgets.
+    API_FIELD() int32 EvictedResourcesCount = 0;
 };
 
 /// <summary>
@@ -30,6 +40,11 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Streaming);
     /// </summary>
     API_FIELD() static Array<TextureGroup, InlinedAllocation<32>> TextureGroups;
 
+    /// <summary>
+    /// The memory budget for all the streamed resources (in bytes). When streaming goes over the budget, the lowest value mips and LODs get evicted first. Use 0 to disable the limit. Per-group budgets are set on StreamingGroup.
+    /// </summary>
+    API_FIELD() static uint64 MemoryBudget;
+
     /// <summary>
     /// Gets streaming statistics.
     /// </summary>
@@ -21,6 +21,13 @@ class FLAXENGINE_API StreamingGroup
     Type _type;
     IStreamingHandler* _handler;
 
+public:
+
+    /// <summary>
+    /// The memory budget for the resources in this group (in bytes). Lowest value resources get their quality decreased when streaming goes over the budget. Use 0 to disable the limit.
+    /// </summary>
+    uint64 MemoryBudget = 0;
+
 public:
 
     /// <summary>
@@ -33,6 +33,19 @@ float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resou
     return result;
 }
 
+float TexturesStreamingHandler::CalculateScreenImpact(StreamableResource* resource, double currentTime)
+{
+    ASSERT(resource);
+    auto& texture = *(StreamingTexture*)resource;
+
+    // Recently rendered textures are the most important, others fade out with the time since the last usage
+    const double lastRenderTime = texture.GetTexture()->LastRenderTime;
+    if (lastRenderTime < 0)
+        return 0.01f;
+    const float timeSinceRender = (float)Math::Max(currentTime - lastRenderTime, 0.0);
+    return Math::Max(1.0f / (1.0f + timeSinceRender), 0.01f);
+}
+
 int32 TexturesStreamingHandler::CalculateResidency(StreamableResource* resource, float quality)
 {
     if (quality < ZeroTolerance)
@@ -12,6 +12,7 @@ class FLAXENGINE_API TexturesStreamingHandler : public IStreamingHandler
 public:
     // [IStreamingHandler]
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
+    float CalculateScreenImpact(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
 };
@@ -19,6 +19,30 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingSettings);
     API_FIELD(Attributes="EditorOrder(100), EditorDisplay(\"Textures\")")
     Array<TextureGroup, InlinedAllocation<32>> TextureGroups;
 
+    /// <summary>
+    /// The memory budget for all the streamed resources (in megabytes). When streaming goes over the budget, the lowest value mips and LODs (based on the resource quality and screen impact) are evicted first. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), Limit(0), EditorDisplay(\"Memory Budget\")")
+    int32 MemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget for the streamed textures (in megabytes). Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), Limit(0), EditorDisplay(\"Memory Budget\")")
+    int32 TexturesMemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget for the streamed models (in megabytes). Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), Limit(0), EditorDisplay(\"Memory Budget\")")
+    int32 ModelsMemoryBudget = 0;
+
+    /// <summary>
+    /// The memory budget for the streamed skinned models (in megabytes). Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), Limit(0), EditorDisplay(\"Memory Budget\")")
+    int32 SkinnedModelsMemoryBudget = 0;
+
 public:
 
     /// <summary>
@@ -0,0 +1,136 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Threading/JobSystem.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TEST_CASE("JobSystem")
+{
+    SECTION("Execute")
+    {
+        Array<int32> data;
+        data.Resize(1000);
+        data.SetAll(0);
+        JobSystem::Execute([&](int32 i)
+        {
+            data[i] += i;
+        }, data.Count());
+        bool valid = true;
+        for (int32 i = 0; i < data.Count(); i++)
+            valid &= data[i] == i;
+        CHECK(valid);
+    }
+
+    SECTION("Dispatch")
+    {
+        volatile int64 counter = 0;
+        const int64 label1 = JobSystem::Dispatch([&](int32 i)
+        {
+            Platform::InterlockedAdd(&counter, i);
+        }, 100);
+        const int64 label2 = JobSystem::Dispatch([&](int32 i)
+        {
+            Platform::InterlockedIncrement(&counter);
+        }, 10);
+        CHECK(label2 > label1);
+        JobSystem::Wait(label1);
+        JobSystem::Wait(label2);
+        CHECK(Platform::AtomicRead(&counter) == 4950 + 10);
+    }
+
+    SECTION("Priorities")
+    {
+        volatile int64 counters[(int32)JobPriority::MAX] = {};
+        int64 labels[(int32)JobPriority::MAX];
+        for (int32 priority = (int32)JobPriority::MAX - 1; priority >= 0; priority--)
+        {
+            labels[priority] = JobSystem::Dispatch([&counters, priority](int32 i)
+            {
+                Platform::InterlockedIncrement(&counters[priority]);
+            }, 50, (JobPriority)priority);
+        }
+        for (int32 priority = 0; priority < (int32)JobPriority::MAX; priority++)
+        {
+            JobSystem::Wait(labels[priority]);
+            CHECK(Platform::AtomicRead(&counters[priority]) == 50);
+        }
+
+        // High priority jobs dispatched after the queued background jobs run ahead of them
+        constexpr int32 backgroundCount = 200;
+        volatile int64 backgroundStarted = 0;
+        JobSystem::SetJobStartingOnDispatch(false);
+        const int64 backgroundLabel = JobSystem::Dispatch([&](int32 i)
+        {
+            Platform::InterlockedIncrement(&backgroundStarted);
+            Platform::Sleep(1);
+        }, backgroundCount, JobPriority::Background);
+        const int64 highLabel = JobSystem::Dispatch([&](int32 i)
+        {
+        }, 10, JobPriority::High);
+        JobSystem::SetJobStartingOnDispatch(true);
+        JobSystem::Wait(highLabel);
+        CHECK(Platform::AtomicRead(&backgroundStarted) < backgroundCount);
+
+        // Background jobs still make progress
+        JobSystem::Wait(backgroundLabel);
+        CHECK(Platform::AtomicRead(&backgroundStarted) == backgroundCount);
+    }
+
+    SECTION("Nested")
+    {
+        // Waiting inside the job executes other jobs so nested dispatches cannot deadlock even when all threads wait
+        volatile int64 counter = 0;
+        JobSystem::Execute([&](int32 i)
+        {
+            JobSystem::Execute([&](int32 j)
+            {
+                Platform::InterlockedIncrement(&counter);
+            }, 16);
+        }, JobSystem::GetThreadsCount() * 4);
+        CHECK(Platform::AtomicRead(&counter) == JobSystem::GetThreadsCount() * 4 * 16);
+    }
+
+    SECTION("ParallelFor")
+    {
+        Array<int32> data;
+        data.Resize(100000);
+        for (int32 grainSize : { 0, 1, 1000 })
+        {
+            data.SetAll(0);
+            JobSystem::ParallelFor(10, data.Count(), grainSize, [&](int32 start, int32 end)
+            {
+                for (int32 i = start; i < end; i++)
+                    data[i]++;
+            });
+            bool valid = true;
+            for (int32 i = 0; i < data.Count(); i++)
+                valid &= data[i] == (i < 10 ? 0 : 1);
+            CHECK(valid);
+        }
+    }
+}
+
+// Compares jobs scheduling overhead between JOB_SYSTEM_USE_MUTEX/JOB_SYSTEM_USE_STEALING backends (see JobSystem.cpp), run with '[.benchmark]' tag
+TEST_CASE("JobSystem Benchmark", "[JobSystem][.benchmark]")
+{
+    constexpr int32 jobCount = 500;
+    constexpr int32 iterations = 100;
+    uint64 enqueueCycles = 0, totalCycles = 0;
+    volatile int64 counter = 0;
+    for (int32 iteration = 0; iteration < iterations; iteration++)
+    {
+        const uint64 start = Platform::GetTimeCycles();
+        const int64 label = JobSystem::Dispatch([&](int32 i)
+        {
+            Platform::InterlockedIncrement(&counter);
+        }, jobCount);
+        const uint64 enqueued = Platform::GetTimeCycles();
+        JobSystem::Wait(label);
+        const uint64 end = Platform::GetTimeCycles();
+        enqueueCycles += enqueued - start;
+        totalCycles += end - start;
+    }
+    CHECK(Platform::AtomicRead(&counter) == jobCount * iterations);
+    LOG(Info, "JobSystem: {0} jobs on {1} threads, enqueue={2} cycles/job, dispatch+execute+wait={3} cycles/job", jobCount, JobSystem::GetThreadsCount(), enqueueCycles / (jobCount * iterations), totalCycles / (jobCount * iterations));
+}
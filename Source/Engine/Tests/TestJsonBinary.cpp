@@ -0,0 +1,150 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Serialization/JsonBinary.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    const char* TestJson = "{"
+        "\"Null\": null, \"False\": false, \"True\": true,"
+        "\"Int\": [0, 1, -1, 2147483647, -2147483648],"
+        "\"Uint\": [2147483648, 4294967295],"
+        "\"Int64\": [-2147483649, -9223372036854775808],"
+        "\"Uint64\": [4294967296, 9223372036854775807, 18446744073709551615],"
+        "\"Double\": [0.5, -0.0, 1.7976931348623157e308, -1.7976931348623157e308, 2.2250738585072014e-308, 4.9406564584124654e-324],"
+        "\"String\": [\"\", \"Name\", \"Name\", \"\\u0142\\u00f3d\\u017a\"],"
+        "\"Name\": \"Name\","
+        "\"EmptyObject\": {}, \"EmptyArray\": [],"
+        "\"Nested\": [{\"Name\": {\"Name\": [[], {}]}}]"
+        "}";
+
+    void WriteJson(const char* json, Array<byte>& data)
+    {
+        rapidjson_flax::Document document;
+        document.Parse(json);
+        REQUIRE(!document.HasParseError());
+        MemoryWriteStream stream;
+        JsonBinary::Write(stream, document);
+        data.Set(stream.GetHandle(), (int32)stream.GetPosition());
+    }
+
+    bool ReadJson(const Array<byte>& data, int32 length, rapidjson_flax::Document& document)
+    {
+        MemoryReadStream stream(data.Get(), length);
+        return JsonBinary::Read(stream, document);
+    }
+}
+
+TEST_CASE("JsonBinary")
+{
+    SECTION("Round Trip")
+    {
+        rapidjson_flax::Document expected;
+        expected.Parse(TestJson);
+        REQUIRE(!expected.HasParseError());
+        Array<byte> data;
+        WriteJson(TestJson, data);
+        CHECK(JsonBinary::IsBinary(data.Get(), data.Count()));
+        rapidjson_flax::Document document;
+        REQUIRE(!ReadJson(data, data.Count(), document));
+        CHECK(document == expected);
+
+        // Numbers keep their types
+        CHECK(document["Int"][4].IsInt());
+        CHECK(document["Int"][4].GetInt() == MIN_int32);
+        CHECK(!document["Uint"][1].IsInt());
+        CHECK(document["Uint"][1].GetUint() == MAX_uint32);
+        CHECK(!document["Int64"][1].IsInt());
+        CHECK(document["Int64"][1].GetInt64() == MIN_int64);
+        CHECK(!document["Uint64"][2].IsInt64());
+        CHECK(document["Uint64"][2].GetUint64() == MAX_uint64);
+        CHECK(document["Double"][0].IsDouble());
+        CHECK(document["Double"][5].GetDouble() == expected["Double"][5].GetDouble());
+        CHECK(document["EmptyObject"].IsObject());
+        CHECK(document["EmptyObject"].MemberCount() == 0);
+        CHECK(document["EmptyArray"].IsArray());
+        CHECK(document["EmptyArray"].Size() == 0);
+    }
+
+    SECTION("Root Values")
+    {
+        const char* tests[] = { "null", "true", "-5", "1.25", "\"\"", "[]", "{}" };
+        for (const char* json : tests)
+        {
+            rapidjson_flax::Document expected;
+            expected.Parse(json);
+            Array<byte> data;
+            WriteJson(json, data);
+            rapidjson_flax::Document document;
+            CHECK(!ReadJson(data, data.Count(), document));
+            CHECK(document == expected);
+        }
+    }
+
+    SECTION("Repeated Strings")
+    {
+        // Repeated keys and values are stored once in the strings table
+        Array<byte> once, repeated;
+        WriteJson("[{\"Name\": \"Value\"}]", once);
+        WriteJson("[{\"Name\": \"Value\"}, {\"Name\": \"Value\"}, {\"Name\": \"Value\"}]", repeated);
+        CHECK(repeated.Count() == once.Count() + 2 * (1 + 4 + 4 + 1 + 4));
+    }
+
+    SECTION("Truncated Data")
+    {
+        Array<byte> data;
+        WriteJson(TestJson, data);
+        for (int32 length = 0; length < data.Count(); length++)
+        {
+            rapidjson_flax::Document document;
+            CHECK(ReadJson(data, length, document));
+        }
+    }
+
+    SECTION("Corrupted Data")
+    {
+        Array<byte> source;
+        WriteJson(TestJson, source);
+        int32 stringsCount, stringsSize;
+        Platform::MemoryCopy(&stringsCount, source.Get() + 8, sizeof(int32));
+        Platform::MemoryCopy(&stringsSize, source.Get() + 12, sizeof(int32));
+        const int32 valuesOffset = 16 + stringsCount * sizeof(int32) + stringsSize;
+        REQUIRE(valuesOffset < source.Count());
+        rapidjson_flax::Document document;
+
+        // Magic
+        Array<byte> data = source;
+        data[0] ^= 0xFF;
+        CHECK(ReadJson(data, data.Count(), document));
+
+        // Version
+        data = source;
+        data[4]++;
+        CHECK(ReadJson(data, data.Count(), document));
+
+        // Strings count
+        data = source;
+        data[11] = 0x80;
+        CHECK(ReadJson(data, data.Count(), document));
+        data[11] = 0x7F;
+        CHECK(ReadJson(data, data.Count(), document));
+
+        // String length
+        data = source;
+        data[16]++;
+        CHECK(ReadJson(data, data.Count(), document));
+
+        // Value tag
+        data = source;
+        data[valuesOffset] = 0xEE;
+        CHECK(ReadJson(data, data.Count(), document));
+
+        // Object members count
+        data = source;
+        data[valuesOffset + 4] = 0x7F;
+        CHECK(ReadJson(data, data.Count(), document));
+    }
+}
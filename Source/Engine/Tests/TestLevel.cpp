@@ -1,10 +1,15 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/RandomStream.h"
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/StringView.h"
 #include "Engine/Level/LargeWorlds.h"
 #include "Engine/Level/Tags.h"
+#include "Engine/Level/Scene/SceneRenderingTree.h"
+#include "Engine/Level/Scene/SceneRenderingCulling.h"
+#include "Engine/Core/Log.h"
 #include <ThirdParty/catch2/catch.hpp>
 
 TEST_CASE("LargeWorlds")
@@ -20,6 +25,174 @@ TEST_CASE("LargeWorlds")
     }
 }
 
+TEST_CASE("SceneRenderingTree")
+{
+    SECTION("Query")
+    {
+        // Random objects in a large area
+        RandomStream rand(1234);
+        Array<BoundingSphere> spheres;
+        Array<int32> leaves;
+        SceneRenderingTree tree;
+        for (int32 i = 0; i < 2000; i++)
+        {
+            const BoundingSphere sphere(Vector3(rand.GetFraction() - 0.5f, rand.GetFraction() - 0.5f, rand.GetFraction() - 0.5f) * 20000.0f, 10.0f + rand.GetFraction() * 100.0f);
+            spheres.Add(sphere);
+            leaves.Add(tree.Add(sphere, i));
+        }
+        CHECK(tree.GetHeight() < 40);
+
+        // Move some objects and remove others
+        for (int32 i = 0; i < 2000; i += 3)
+        {
+            spheres[i].Center += Vector3(rand.GetFraction() - 0.5f, 0.0f, rand.GetFraction() - 0.5f) * 5000.0f;
+            tree.Update(leaves[i], spheres[i]);
+        }
+        for (int32 i = 1; i < 2000; i += 7)
+        {
+            tree.Remove(leaves[i]);
+            leaves[i] = -1;
+        }
+
+        // Compare query results with the brute-force culling
+        Matrix view, projection, viewProjection;
+        Matrix::LookAt(Float3(-2000, 0, 0), Float3(1000, 0, 500), Float3::Up, view);
+        Matrix::PerspectiveFov(1.0f, 1.0f, 10.0f, 10000.0f, projection);
+        Matrix::Multiply(view, projection, viewProjection);
+        const BoundingFrustum frustum(viewProjection);
+        Array<int32> result;
+        tree.Query(&frustum, 1, Vector3::Zero, result);
+        Array<bool> visible;
+        visible.Resize(spheres.Count());
+        visible.SetAll(false);
+        for (int32 key : result)
+        {
+            CHECK(leaves[key] != -1);
+            CHECK(!visible[key]);
+            visible[key] = true;
+        }
+        int32 expectedCount = 0;
+        bool valid = true;
+        for (int32 i = 0; i < spheres.Count(); i++)
+        {
+            if (leaves[i] != -1 && frustum.Intersects(spheres[i]))
+            {
+                expectedCount++;
+                valid &= visible[i];
+            }
+        }
+        CHECK(valid);
+        CHECK(expectedCount > 0);
+        CHECK(result.Count() < spheres.Count() / 2);
+    }
+}
+
+static BoundingFrustum GetTestFrustum(const Float3& position, const Float3& target)
+{
+    Matrix view, projection, viewProjection;
+    Matrix::LookAt(position, target, Float3::Up, view);
+    Matrix::PerspectiveFov(1.0f, 1.0f, 10.0f, 10000.0f, projection);
+    Matrix::Multiply(view, projection, viewProjection);
+    return BoundingFrustum(viewProjection);
+}
+
+static void GetTestSpheres(SceneRenderingCulling& culling, Array<BoundingSphere>& spheres, int32 count)
+{
+    RandomStream rand(1234);
+    spheres.Resize(count);
+    culling.Resize(count);
+    for (int32 i = 0; i < count; i++)
+    {
+        spheres[i] = BoundingSphere(Vector3(rand.GetFraction() - 0.5f, rand.GetFraction() - 0.5f, rand.GetFraction() - 0.5f) * 20000.0f, 10.0f + rand.GetFraction() * 100.0f);
+        culling.Set(i, spheres[i], 1 << (i % 4), false);
+    }
+}
+
+TEST_CASE("SceneRenderingCulling")
+{
+    SECTION("Cull")
+    {
+        SceneRenderingCulling culling;
+        Array<BoundingSphere> spheres;
+        GetTestSpheres(culling, spheres, 1001);
+        const BoundingFrustum frustums[2] = { GetTestFrustum(Float3(-2000, 0, 0), Float3(1000, 0, 500)), GetTestFrustum(Float3(0, 3000, 0), Float3(0, 0, 0)) };
+        const Vector3 origin(100, 200, 300);
+        Array<int32> indices;
+        for (int32 i = 0; i < spheres.Count(); i += 3)
+            indices.Add(i);
+        Array<int32> result;
+        result.Resize(spheres.Count());
+        for (int32 frustumsCount = 1; frustumsCount <= 2; frustumsCount++)
+        {
+            for (const bool useIndices : { false, true })
+            {
+                // Test unaligned range with all layers except the last one
+                const int32 start = 3;
+                const int32 count = (useIndices ? indices.Count() : spheres.Count()) - start;
+                const uint32 layerMask = 0x7;
+                const int32 resultCount = culling.Cull(start, count, useIndices ? indices.Get() : nullptr, frustums, frustumsCount, origin, layerMask, result.Get());
+
+                // Compare with the per-sphere culling (with a small tolerance for the precision differences)
+                Array<bool> visible;
+                visible.Resize(spheres.Count());
+                visible.SetAll(false);
+                bool valid = true;
+                for (int32 i = 0; i < resultCount; i++)
+                {
+                    const int32 index = result[i];
+                    valid &= !visible[index] && (layerMask & (1 << (index % 4))) != 0;
+                    visible[index] = true;
+                }
+                int32 expectedCount = 0;
+                for (int32 i = start; i < start + count; i++)
+                {
+                    const int32 index = useIndices ? indices[i] : i;
+                    if ((layerMask & (1 << (index % 4))) == 0)
+                        continue;
+                    bool inside = false, insideLoose = false;
+                    for (int32 frustumIndex = 0; frustumIndex < frustumsCount; frustumIndex++)
+                    {
+                        inside |= frustums[frustumIndex].Intersects(BoundingSphere(spheres[index].Center - origin, spheres[index].Radius - 0.1f));
+                        insideLoose |= frustums[frustumIndex].Intersects(BoundingSphere(spheres[index].Center - origin, spheres[index].Radius + 0.1f));
+                    }
+                    expectedCount += inside ? 1 : 0;
+                    valid &= visible[index] ? insideLoose : !inside;
+                }
+                CHECK(valid);
+                CHECK(expectedCount > 0);
+            }
+        }
+    }
+}
+
+// Compares per-sphere frustum culling with a batched culling, run with '[.benchmark]' tag
+TEST_CASE("SceneRenderingCulling Benchmark", "[SceneRenderingCulling][.benchmark]")
+{
+    constexpr int32 count = 1000000;
+    SceneRenderingCulling culling;
+    Array<BoundingSphere> spheres;
+    GetTestSpheres(culling, spheres, count);
+    const BoundingFrustum frustum = GetTestFrustum(Float3(-2000, 0, 0), Float3(1000, 0, 500));
+    Array<int32> result;
+    result.Resize(count);
+
+    uint64 start = Platform::GetTimeCycles();
+    int32 resultCountSingle = 0;
+    for (int32 i = 0; i < count; i++)
+    {
+        if (frustum.Intersects(spheres[i]))
+            result[resultCountSingle++] = i;
+    }
+    const uint64 cyclesSingle = Platform::GetTimeCycles() - start;
+
+    start = Platform::GetTimeCycles();
+    const int32 resultCountBatch = culling.Cull(0, count, nullptr, &frustum, 1, Vector3::Zero, MAX_uint32, result.Get());
+    const uint64 cyclesBatch = Platform::GetTimeCycles() - start;
+
+    CHECK(Math::Abs(resultCountSingle - resultCountBatch) <= 10);
+    LOG(Info, "SceneRenderingCulling: {0} spheres, visible={1}, per-sphere={2} cycles, batched={3} cycles", count, resultCountBatch, cyclesSingle, cyclesBatch);
+}
+
 TEST_CASE("Tags")
 {
     SECTION("Tag")
@@ -0,0 +1,190 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "TestNetworking.h"
+#include "Engine/Networking/NetworkPeer.h"
+#include "Engine/Networking/NetworkEvent.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+TestNetworkDriver::TestNetworkDriver(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+bool TestNetworkDriver::Initialize(NetworkPeer* host, const NetworkConfig& config)
+{
+    _host = host;
+    return false;
+}
+
+void TestNetworkDriver::Dispose()
+{
+    Packets.Clear();
+    _host = nullptr;
+}
+
+bool TestNetworkDriver::Listen()
+{
+    return false;
+}
+
+bool TestNetworkDriver::Connect()
+{
+    return false;
+}
+
+void TestNetworkDriver::Disconnect()
+{
+}
+
+void TestNetworkDriver::Disconnect(const NetworkConnection& connection)
+{
+}
+
+bool TestNetworkDriver::PopEvent(NetworkEvent& eventPtr)
+{
+    if (Packets.IsEmpty())
+        return false;
+    const Packet& packet = Packets[0];
+    eventPtr.EventType = NetworkEventType::Message;
+    eventPtr.Sender = packet.Target;
+    eventPtr.Message = _host->CreateMessage();
+    eventPtr.Message.Length = packet.Data.Count();
+    Platform::MemoryCopy(eventPtr.Message.Buffer, packet.Data.Get(), packet.Data.Count());
+    Packets.RemoveAtKeepOrder(0);
+    return true;
+}
+
+void TestNetworkDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message)
+{
+    SendMessage(channelType, message, NetworkConnection{ 0 });
+}
+
+void TestNetworkDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target)
+{
+    Packet& packet = Packets.AddOne();
+    packet.ChannelType = channelType;
+    packet.Target = target;
+    packet.Data.Set(message.Buffer, (int32)message.Length);
+}
+
+void TestNetworkDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets)
+{
+    for (const NetworkConnection& target : targets)
+        SendMessage(channelType, message, target);
+}
+
+NetworkDriverStats TestNetworkDriver::GetStats()
+{
+    return NetworkDriverStats();
+}
+
+NetworkDriverStats TestNetworkDriver::GetStats(NetworkConnection target)
+{
+    return NetworkDriverStats();
+}
+
+namespace
+{
+    bool SendTestMessage(NetworkPeer* peer, const NetworkConnection& target, byte first, int32 length)
+    {
+        NetworkMessage message = peer->BeginSendMessage();
+        for (int32 i = 0; i < length; i++)
+            message.WriteUInt8(i == 0 ? first : (byte)i);
+        return peer->EndSendMessage(NetworkChannelType::ReliableOrdered, message, target);
+    }
+
+    bool ReceiveTestMessage(NetworkPeer* peer, byte first, int32 length)
+    {
+        NetworkEvent e;
+        if (!peer->PopEvent(e))
+            return false;
+        bool valid = e.EventType == NetworkEventType::Message && e.Message.Length == length;
+        for (int32 i = 0; valid && i < length; i++)
+            valid = e.Message.Buffer[i] == (i == 0 ? first : (byte)i);
+        peer->RecycleMessage(e.Message);
+        return valid;
+    }
+}
+
+TEST_CASE("Networking")
+{
+    NetworkConfig config;
+    config.Address = TEXT("any");
+    config.NetworkDriver = New<TestNetworkDriver>();
+    config.MessageSize = 64;
+    config.MessagePoolSize = 256;
+    config.MessageBatching = true;
+    NetworkPeer* peer = NetworkPeer::CreatePeer(config);
+    REQUIRE(peer);
+    TestNetworkDriver* driver = (TestNetworkDriver*)peer->Config.NetworkDriver;
+    const NetworkConnection target{ 1 };
+
+    SECTION("Batching Order")
+    {
+        CHECK(!SendTestMessage(peer, target, 1, 10));
+        CHECK(!SendTestMessage(peer, target, 2, 20));
+        CHECK(!SendTestMessage(peer, target, 3, 5));
+        CHECK(driver->Packets.Count() == 0);
+        peer->Flush();
+        REQUIRE(driver->Packets.Count() == 1);
+        CHECK(peer->GetStats().MessagesSent == 3);
+        CHECK(peer->GetStats().PacketsSent == 1);
+        CHECK(peer->GetStats().PacketsSaved == 2);
+        CHECK(ReceiveTestMessage(peer, 1, 10));
+        CHECK(ReceiveTestMessage(peer, 2, 20));
+        CHECK(ReceiveTestMessage(peer, 3, 5));
+        NetworkEvent e;
+        CHECK(!peer->PopEvent(e));
+        CHECK(peer->GetStats().PacketsReceived == 1);
+        CHECK(peer->GetStats().MessagesReceived == 3);
+    }
+
+    SECTION("Batching Full")
+    {
+        // Each message takes 22 bytes in the batch so only two fit into a single packet
+        for (int32 i = 0; i < 5; i++)
+            CHECK(!SendTestMessage(peer, target, (byte)i, 20));
+        peer->Flush();
+        CHECK(driver->Packets.Count() == 3);
+        CHECK(peer->GetStats().PacketsSaved == 2);
+        for (int32 i = 0; i < 5; i++)
+            CHECK(ReceiveTestMessage(peer, (byte)i, 20));
+    }
+
+    SECTION("Single Message")
+    {
+        // Single message is still sent within a batch so user data starting with the marker byte is received unchanged
+        CHECK(!SendTestMessage(peer, target, 0xFF, 8));
+        peer->Flush();
+        REQUIRE(driver->Packets.Count() == 1);
+        CHECK(driver->Packets[0].Data.Count() == 8 + 3);
+        CHECK(peer->GetStats().PacketsSaved == 0);
+        CHECK(ReceiveTestMessage(peer, 0xFF, 8));
+        NetworkEvent e;
+        CHECK(!peer->PopEvent(e));
+    }
+
+    SECTION("Oversize Message")
+    {
+        // Too large message is sent directly after the earlier batched messages
+        CHECK(!SendTestMessage(peer, target, 1, 10));
+        CHECK(!SendTestMessage(peer, target, 2, 62));
+        CHECK(driver->Packets.Count() == 2);
+        CHECK(driver->Packets[1].Data.Count() == 62);
+        CHECK(!SendTestMessage(peer, target, 3, 10));
+        peer->Flush();
+        CHECK(driver->Packets.Count() == 3);
+        CHECK(ReceiveTestMessage(peer, 1, 10));
+        CHECK(ReceiveTestMessage(peer, 2, 62));
+        CHECK(ReceiveTestMessage(peer, 3, 10));
+
+        // Too large message cannot start with the batch marker byte
+        CHECK(SendTestMessage(peer, target, 0xFF, 62));
+        peer->Flush();
+        CHECK(driver->Packets.Count() == 0);
+        CHECK(peer->GetStats().MessagesSent == 3);
+        CHECK(peer->GetStats().PacketsSaved == 0);
+    }
+
+    NetworkPeer::ShutdownPeer(peer);
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Networking/INetworkDriver.h"
+#include "Engine/Networking/NetworkConnection.h"
+#include "Engine/Networking/NetworkChannelType.h"
+#include "Engine/Networking/NetworkStats.h"
+#include "Engine/Scripting/ScriptingObject.h"
+
+// Test network driver that keeps sent packets in memory and receives them back (loopback).
+API_CLASS(Sealed) class TestNetworkDriver : public ScriptingObject, public INetworkDriver
+{
+    DECLARE_SCRIPTING_TYPE(TestNetworkDriver);
+
+public:
+    struct Packet
+    {
+        NetworkChannelType ChannelType;
+        NetworkConnection Target;
+        Array<byte> Data;
+    };
+
+    // Packets sent by the peer and not yet received.
+    Array<Packet> Packets;
+
+private:
+    NetworkPeer* _host = nullptr;
+
+public:
+    // [INetworkDriver]
+    bool Initialize(NetworkPeer* host, const NetworkConfig& config) override;
+    void Dispose() override;
+    bool Listen() override;
+    bool Connect() override;
+    void Disconnect() override;
+    void Disconnect(const NetworkConnection& connection) override;
+    bool PopEvent(NetworkEvent& eventPtr) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
+    NetworkDriverStats GetStats() override;
+    NetworkDriverStats GetStats(NetworkConnection target) override;
+};
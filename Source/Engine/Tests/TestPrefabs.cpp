@@ -557,4 +557,138 @@ TEST_CASE("Prefabs")
         Content::DeleteAsset(prefabNested1);
         Content::DeleteAsset(prefabBase);
     }
+    SECTION("Test Spawning Multiple Prefab Instances")
+    {
+        // Create Prefab with a child
+        AssetReference<Prefab> prefab = Content::CreateVirtualAsset<Prefab>();
+        REQUIRE(prefab);
+        Guid id;
+        Guid::Parse("5b7d9f1e3a2c4b6d8f0e2a4c6b8d0f13", id);
+        prefab->ChangeID(id);
+        auto prefabInit = prefab->Init(Prefab::TypeName,
+                                       "["
+                                       "{"
+                                       "\"ID\": \"9e7c5a3b1d0f4e2c8b6a4d2f0e8c6a45\","
+                                       "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                       "\"Name\": \"Root\""
+                                       "},"
+                                       "{"
+                                       "\"ID\": \"2f4a6c8e0b1d4f3a5c7e9b0d2f4a6c87\","
+                                       "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                       "\"ParentID\": \"9e7c5a3b1d0f4e2c8b6a4d2f0e8c6a45\","
+                                       "\"Name\": \"Child\""
+                                       "}"
+                                       "]");
+        REQUIRE(!prefabInit);
+
+        // Spawn instances in a batch
+        Array<Transform> transforms;
+        for (int32 i = 0; i < 3; i++)
+            transforms.Add(Transform(Vector3((float)i * 100.0f, 0, 0)));
+        Array<Actor*> instances = PrefabManager::SpawnPrefabs(prefab, transforms, nullptr);
+
+        // Verify instances
+        REQUIRE(instances.Count() == transforms.Count());
+        for (int32 i = 0; i < instances.Count(); i++)
+        {
+            Actor* instance = instances[i];
+            REQUIRE(instance);
+            CHECK(instance->GetName() == TEXT("Root"));
+            CHECK(instance->IsPrefabRoot());
+            CHECK(instance->GetPrefabID() == prefab->GetID());
+            CHECK(instance->GetPosition() == transforms[i].Translation);
+            REQUIRE(instance->GetChildrenCount() == 1);
+            CHECK(instance->Children[0]->GetName() == TEXT("Child"));
+            CHECK(instance->Children[0]->GetPrefabID() == prefab->GetID());
+            for (int32 j = 0; j < i; j++)
+            {
+                CHECK(instance->GetID() != instances[j]->GetID());
+                CHECK(instance->Children[0]->GetID() != instances[j]->Children[0]->GetID());
+            }
+        }
+
+        // Cleanup
+        for (Actor* instance : instances)
+            instance->DeleteObject();
+        Content::DeleteAsset(prefab);
+    }
+    SECTION("Test Pooling Prefab Instances")
+    {
+        // Create Prefab with a child moved away from the root
+        AssetReference<Prefab> prefab = Content::CreateVirtualAsset<Prefab>();
+        REQUIRE(prefab);
+        Guid id;
+        Guid::Parse("8a2f6e5d4b1c4e0f9d3a7b6c5e4f3a21", id);
+        prefab->ChangeID(id);
+        auto prefabInit = prefab->Init(Prefab::TypeName,
+                                       "["
+                                       "{"
+                                       "\"ID\": \"3c1e9a7b5d2f4c6e8a0b1d3f5e7c9a2b\","
+                                       "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                       "\"Name\": \"Root\""
+                                       "},"
+                                       "{"
+                                       "\"ID\": \"6d4b2f0e8c1a4d3b9e5f7a2c4b6d8e01\","
+                                       "\"TypeName\": \"FlaxEngine.EmptyActor\","
+                                       "\"ParentID\": \"3c1e9a7b5d2f4c6e8a0b1d3f5e7c9a2b\","
+                                       "\"Name\": \"Child\","
+                                       "\"Transform\": { \"Translation\": { \"X\": 0.0, \"Y\": 10.0, \"Z\": 0.0 } }"
+                                       "}"
+                                       "]");
+        REQUIRE(!prefabInit);
+
+        // Spawn instance and modify it
+        ScriptingObjectReference<Actor> instance = PrefabManager::SpawnPooled(prefab, Transform(Vector3(100, 0, 0)));
+        REQUIRE(instance);
+        REQUIRE(instance->IsPrefabRoot());
+        REQUIRE(instance->GetChildrenCount() == 1);
+        ScriptingObjectReference<Actor> child = instance->Children[0];
+        CHECK(child->GetLocalTransform().Translation == Vector3(0, 10, 0));
+        child->SetLocalTransform(Transform(Vector3(5, 5, 5)));
+        child->SetIsActive(false);
+
+        // Despawn non-root actor of the prefab instance (gets deleted instead of pooled)
+        ScriptingObjectReference<Actor> other = PrefabManager::SpawnPrefab(prefab);
+        REQUIRE(other);
+        REQUIRE(other->GetChildrenCount() == 1);
+        Actor* otherChild = other->Children[0];
+        REQUIRE(!otherChild->IsPrefabRoot());
+        PrefabManager::Despawn(otherChild);
+        CHECK(EnumHasAnyFlags(otherChild->Flags, ObjectFlags::WasMarkedToDelete));
+
+        // Despawn and reuse the instance
+        PrefabManager::Despawn(instance);
+        CHECK(instance);
+        CHECK(!instance->GetIsActive());
+        Actor* reused = PrefabManager::SpawnPooled(prefab, Transform(Vector3(0, 200, 0)));
+        CHECK(reused == instance.Get());
+        CHECK(instance->GetIsActive());
+        CHECK(instance->GetPosition() == Vector3(0, 200, 0));
+        CHECK(child == instance->Children[0]);
+        CHECK(child->GetLocalTransform().Translation == Vector3(0, 10, 0));
+        CHECK(child->GetIsActive());
+
+        // Spawn a new instance when pool is empty
+        ScriptingObjectReference<Actor> spawned = PrefabManager::SpawnPooled(prefab, Transform::Identity);
+        REQUIRE(spawned);
+        CHECK(spawned.Get() != instance.Get());
+
+        // Full pool with a deleted instance parked (eg. unloaded with its scene) still accepts a new one
+        const int32 poolCapacity = PrefabManager::PoolCapacity;
+        PrefabManager::PoolCapacity = 1;
+        PrefabManager::Despawn(spawned);
+        CHECK(!spawned->GetIsActive());
+        spawned->DeleteObject();
+        PrefabManager::Despawn(instance);
+        CHECK(!EnumHasAnyFlags(instance->Flags, ObjectFlags::WasMarkedToDelete));
+        CHECK(!instance->GetIsActive());
+        CHECK(PrefabManager::SpawnPooled(prefab, Transform::Identity) == instance.Get());
+        PrefabManager::PoolCapacity = poolCapacity;
+
+        // Cleanup
+        PrefabManager::ClearPool(prefab);
+        instance->DeleteObject();
+        other->DeleteObject();
+        Content::DeleteAsset(prefab);
+    }
 }
@@ -151,4 +151,47 @@ TEST_CASE("Scripting")
         CHECK(interfaceObject);
         CHECK(interfaceObject == object);
     }
+
+    SECTION("Test Objects Registry")
+    {
+        // Register objects (spread over all registry shards)
+        Array<ScriptingObject*> objects;
+        for (int32 i = 0; i < 256; i++)
+        {
+            ScriptingObject* object = Scripting::NewObject(TestClassNative::TypeInitializer);
+            REQUIRE(object);
+            object->RegisterObject();
+            objects.Add(object);
+        }
+
+        // Find objects by id and by type
+        for (ScriptingObject* object : objects)
+        {
+            CHECK(object->IsRegistered());
+            CHECK(Scripting::TryFindObject(object->GetID()) == object);
+            CHECK(Scripting::TryFindObject<TestClassNative>(object->GetID()) == object);
+        }
+        ScriptingObject* anyObject = Scripting::TryFindObject(TestClassNative::GetStaticClass());
+        CHECK(anyObject);
+        CHECK(anyObject->Is<TestClassNative>());
+
+        // Change ids (moves objects between shards)
+        for (ScriptingObject* object : objects)
+        {
+            const Guid oldId = object->GetID();
+            object->ChangeID(Guid::New());
+            CHECK(Scripting::TryFindObject(oldId) == nullptr);
+            CHECK(Scripting::TryFindObject(object->GetID()) == object);
+        }
+
+        // Unregister objects
+        for (ScriptingObject* object : objects)
+        {
+            const Guid id = object->GetID();
+            object->UnregisterObject();
+            CHECK(!object->IsRegistered());
+            CHECK(Scripting::TryFindObject(id) == nullptr);
+            object->DeleteObjectNow();
+        }
+    }
 }
@@ -5,6 +5,7 @@
 #include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/Thread.h"
 #include "Engine/Platform/ConditionVariable.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -17,15 +18,22 @@
 // JOB_SYSTEM_USE_MUTEX=1, enqueue=130-280 cycles, dequeue=2-6 cycles
 // JOB_SYSTEM_USE_MUTEX=0, enqueue=300-700 cycles, dequeue=10-16 cycles
 // So using RingBuffer+Mutex+Signals is better than moodycamel::ConcurrentQueue
+// JOB_SYSTEM_USE_STEALING=1 uses per-thread deques with job ranges (split in half when stolen) to avoid a single lock contention on many-core CPUs
+// Use JOB_SYSTEM_USE_STATS=1 or run '[JobSystem][.benchmark]' tests to measure enqueue/dequeue timings
 
 #define JOB_SYSTEM_ENABLED 1
 #define JOB_SYSTEM_USE_MUTEX 1
+#define JOB_SYSTEM_USE_STEALING 0
 #define JOB_SYSTEM_USE_STATS 0
 
+// ParallelFor automatic chunking (in CPU cycles): minimal duration of the first items execution used to estimate the item cost and the target duration of a single chunk
+#define JOB_SYSTEM_PARALLEL_FOR_PROBE_CYCLES 5000
+#define JOB_SYSTEM_PARALLEL_FOR_CHUNK_CYCLES 50000
+
 #if JOB_SYSTEM_USE_STATS
 #include "Engine/Core/Log.h"
 #endif
-#if JOB_SYSTEM_USE_MUTEX
+#if JOB_SYSTEM_USE_STEALING || JOB_SYSTEM_USE_MUTEX
 #include "Engine/Core/Collections/RingBuffer.h"
 #else
 #include "ConcurrentQueue.h"
@@ -46,19 +54,49 @@ class JobSystemService : public EngineService
     void Dispose() override;
 };
 
-struct JobData
+struct JobContext
 {
+    volatile int64 JobsLeft;
+    int64 Label;
+    JobPriority Priority;
     Function<void(int32)> Job;
+};
+
+struct JobData
+{
+    JobContext* Context;
     int32 Index;
-    int64 JobKey;
 };
 
 template<>
 struct TIsPODType<JobData>
 {
-    enum { Value = false };
+    enum { Value = true };
+};
+
+#if JOB_SYSTEM_USE_STEALING
+
+struct JobRange
+{
+    JobContext* Context;
+    int32 Index;
+    int32 Count;
 };
 
+template<>
+struct TIsPODType<JobRange>
+{
+    enum { Value = true };
+};
+
+struct JobQueue
+{
+    CriticalSection Locker;
+    RingBuffer<JobRange> Ranges[(int32)JobPriority::MAX];
+};
+
+#endif
+
 class JobSystemThread : public IRunnable
 {
 public:
@@ -79,17 +117,6 @@ class JobSystemThread : public IRunnable
     }
 };
 
-struct JobContext
-{
-    volatile int64 JobsLeft;
-};
-
-template<>
-struct TIsPODType<JobContext>
-{
-    enum { Value = true };
-};
-
 namespace
 {
     JobSystemService JobSystemInstance;
@@ -98,16 +125,23 @@ namespace
     bool JobStartingOnDispatch = true;
     volatile int64 ExitFlag = 0;
     volatile int64 JobLabel = 0;
-    Dictionary<int64, JobContext> JobContexts;
+    Dictionary<int64, JobContext*> JobContexts;
+    Array<JobContext*> JobContextsPool;
+    CriticalSection ContextsLocker;
     ConditionVariable JobsSignal;
     CriticalSection JobsMutex;
     ConditionVariable WaitSignal;
     CriticalSection WaitMutex;
+    volatile int64 JobsQueued[(int32)JobPriority::MAX] = {};
+#if JOB_SYSTEM_USE_STEALING
+    JobQueue Queues[ARRAY_COUNT(Threads)];
+    THREADLOCAL int32 ThisQueue = -1;
+    volatile int64 QueuesCursor = 0;
+#elif JOB_SYSTEM_USE_MUTEX
     CriticalSection JobsLocker;
-#if JOB_SYSTEM_USE_MUTEX
-    RingBuffer<JobData> Jobs;
+    RingBuffer<JobData> Jobs[(int32)JobPriority::MAX];
 #else
-    ConcurrentQueue<JobData> Jobs;
+    ConcurrentQueue<JobData> Jobs[(int32)JobPriority::MAX];
 #endif
 #if JOB_SYSTEM_USE_STATS
     int64 DequeueCount = 0;
@@ -115,6 +149,239 @@ namespace
 #endif
 }
 
+#if JOB_SYSTEM_USE_STEALING
+
+void PushJobs(JobContext* context, int32 jobCount, int32 priority)
+{
+    JobRange range;
+    range.Context = context;
+    if (ThisQueue != -1)
+    {
+        // Nested dispatch from the job thread goes to the local queue (idle threads will steal from it)
+        range.Index = 0;
+        range.Count = jobCount;
+        JobQueue& queue = Queues[ThisQueue];
+        queue.Locker.Lock();
+        queue.Ranges[priority].PushBack(range);
+        queue.Locker.Unlock();
+        return;
+    }
+
+    // Split jobs into contiguous ranges spread over the threads queues
+    const int32 rangesCount = Math::Min(jobCount, ThreadsCount);
+    const int32 start = (int32)(Platform::InterlockedIncrement(&QueuesCursor) % ThreadsCount);
+    range.Index = 0;
+    for (int32 i = 0; i < rangesCount; i++)
+    {
+        range.Count = (jobCount - range.Index) / (rangesCount - i);
+        JobQueue& queue = Queues[(start + i) % ThreadsCount];
+        queue.Locker.Lock();
+        queue.Ranges[priority].PushBack(range);
+        queue.Locker.Unlock();
+        range.Index += range.Count;
+    }
+}
+
+bool PopJob(JobData& data, int32 priority)
+{
+    // Take the most recent job from the local queue (LIFO for better cache locality)
+    const int32 thisQueue = ThisQueue;
+    if (thisQueue != -1)
+    {
+        JobQueue& queue = Queues[thisQueue];
+        auto& ranges = queue.Ranges[priority];
+        queue.Locker.Lock();
+        if (ranges.Count() != 0)
+        {
+            JobRange& range = ranges.PeekBack();
+            data.Context = range.Context;
+            data.Index = range.Index++;
+            if (--range.Count == 0)
+                ranges.PopBack();
+            queue.Locker.Unlock();
+            return true;
+        }
+        queue.Locker.Unlock();
+    }
+
+    // Steal the oldest jobs from other threads (take half of the range to balance the work)
+    for (int32 i = 1; i <= ThreadsCount; i++)
+    {
+        const int32 victimIndex = (thisQueue + i) % ThreadsCount;
+        if (victimIndex == thisQueue)
+            continue;
+        JobQueue& victim = Queues[victimIndex];
+        auto& victimRanges = victim.Ranges[priority];
+        victim.Locker.Lock();
+        if (victimRanges.Count() == 0)
+        {
+            victim.Locker.Unlock();
+            continue;
+        }
+        JobRange& range = victimRanges.PeekFront();
+        JobRange stolen;
+        stolen.Context = range.Context;
+        stolen.Count = thisQueue != -1 ? (range.Count + 1) / 2 : 1;
+        stolen.Index = range.Index + range.Count - stolen.Count;
+        range.Count -= stolen.Count;
+        if (range.Count == 0)
+            victimRanges.PopFront();
+        victim.Locker.Unlock();
+
+        data.Context = stolen.Context;
+        data.Index = stolen.Index;
+        if (stolen.Count > 1)
+        {
+            // Keep the rest of the stolen jobs in the local queue
+            stolen.Index++;
+            stolen.Count--;
+            JobQueue& queue = Queues[thisQueue];
+            queue.Locker.Lock();
+            queue.Ranges[priority].PushBack(stolen);
+            queue.Locker.Unlock();
+            JobsSignal.NotifyOne();
+        }
+        return true;
+    }
+    return false;
+}
+
+#elif JOB_SYSTEM_USE_MUTEX
+
+void PushJobs(JobContext* context, int32 jobCount, int32 priority)
+{
+    JobData data;
+    data.Context = context;
+    JobsLocker.Lock();
+    for (data.Index = 0; data.Index < jobCount; data.Index++)
+        Jobs[priority].PushBack(data);
+    JobsLocker.Unlock();
+}
+
+bool PopJob(JobData& data, int32 priority)
+{
+    bool result = false;
+    JobsLocker.Lock();
+    if (Jobs[priority].Count() != 0)
+    {
+        data = Jobs[priority].PeekFront();
+        Jobs[priority].PopFront();
+        result = true;
+    }
+    JobsLocker.Unlock();
+    return result;
+}
+
+#else
+
+void PushJobs(JobContext* context, int32 jobCount, int32 priority)
+{
+    JobData data;
+    data.Context = context;
+    for (data.Index = 0; data.Index < jobCount; data.Index++)
+        Jobs[priority].enqueue(data);
+}
+
+bool PopJob(JobData& data, int32 priority)
+{
+    return Jobs[priority].try_dequeue(data);
+}
+
+#endif
+
+void EnqueueJobs(JobContext* context, int32 jobCount)
+{
+    const int32 priority = (int32)context->Priority;
+    Platform::InterlockedAdd(&JobsQueued[priority], jobCount);
+    PushJobs(context, jobCount, priority);
+}
+
+bool DequeueJob(JobData& data, JobPriority lowestPriority)
+{
+    // Pick jobs in the priority order (higher priority jobs never wait behind the lower ones)
+    for (int32 priority = 0; priority <= (int32)lowestPriority; priority++)
+    {
+        if (Platform::AtomicRead(&JobsQueued[priority]) > 0 && PopJob(data, priority))
+        {
+            Platform::InterlockedDecrement(&JobsQueued[priority]);
+            return true;
+        }
+    }
+    return false;
+}
+
+int32 GetJobsQueued()
+{
+    int64 count = 0;
+    for (int32 priority = 0; priority < (int32)JobPriority::MAX; priority++)
+        count += Platform::AtomicRead(&JobsQueued[priority]);
+    return (int32)count;
+}
+
+void RunJob(const JobData& data)
+{
+    JobContext* context = data.Context;
+    context->Job(data.Index);
+
+    // Move forward with the job queue (the last job releases the context)
+    if (Platform::InterlockedDecrement(&context->JobsLeft) <= 0)
+    {
+        context->Job.Unbind();
+        ContextsLocker.Lock();
+        JobContexts.Remove(context->Label);
+        JobContextsPool.Add(context);
+        ContextsLocker.Unlock();
+
+        // Notify under the lock so waiting threads won't miss it between the check and the wait
+        WaitMutex.Lock();
+        WaitSignal.NotifyAll();
+        WaitMutex.Unlock();
+    }
+}
+
+bool IsJobPending(int64 label)
+{
+    ContextsLocker.Lock();
+    const bool result = label < 0 ? JobContexts.HasItems() : JobContexts.ContainsKey(label);
+    ContextsLocker.Unlock();
+    return result;
+}
+
+void WaitJob(int64 label)
+{
+    // Help only with jobs of the same or higher priority (don't block the latency-critical waits on the background work)
+    JobPriority lowestPriority = JobPriority::Normal;
+    ContextsLocker.Lock();
+    JobContext* context;
+    if (label >= 0 && JobContexts.TryGet(label, context))
+        lowestPriority = Math::Max(context->Priority, lowestPriority);
+    ContextsLocker.Unlock();
+
+    JobData data;
+    while (Platform::AtomicRead(&ExitFlag) == 0)
+    {
+        // Skip if context has been already executed (last job removes it)
+        if (!IsJobPending(label))
+            break;
+
+        // Help with the jobs execution instead of sleeping (also prevents deadlocks when waiting on a job thread)
+        if (DequeueJob(data, lowestPriority))
+        {
+            RunJob(data);
+            continue;
+        }
+
+        // Wait on signal until input label is not yet done (the remaining jobs are in progress on other threads)
+        WaitMutex.Lock();
+        if (IsJobPending(label))
+            WaitSignal.Wait(WaitMutex, 1);
+        WaitMutex.Unlock();
+
+        // Wake up any thread to prevent stalling in highly multi-threaded environment
+        JobsSignal.NotifyOne();
+    }
+}
+
 bool JobSystemService::Init()
 {
     ThreadsCount = Math::Min<int32>(Platform::GetCPUInfo().LogicalProcessorCount, ARRAY_COUNT(Threads));
@@ -151,41 +418,38 @@ void JobSystemService::Dispose()
             Threads[i] = nullptr;
         }
     }
+
+    ContextsLocker.Lock();
+    JobContexts.ClearDelete();
+    JobContextsPool.ClearDelete();
+    ContextsLocker.Unlock();
 }
 
 int32 JobSystemThread::Run()
 {
     Platform::SetThreadAffinityMask(1ull << Index);
+#if JOB_SYSTEM_USE_STEALING
+    ThisQueue = (int32)Index;
+#endif
+
+    // The last thread is a dedicated lane for the latency-critical work that never runs the background jobs
+    const JobPriority lowestPriority = ThreadsCount > 1 && (int32)Index == ThreadsCount - 1 ? JobPriority::Normal : JobPriority::Background;
 
     JobData data;
     bool attachCSharpThread = true;
-#if !JOB_SYSTEM_USE_MUTEX
-    moodycamel::ConsumerToken consumerToken(Jobs);
-#endif
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
         // Try to get a job
 #if JOB_SYSTEM_USE_STATS
         const auto start = Platform::GetTimeCycles();
 #endif
-#if JOB_SYSTEM_USE_MUTEX
-        JobsLocker.Lock();
-        if (Jobs.Count() != 0)
-        {
-            data = Jobs.PeekFront();
-            Jobs.PopFront();
-        }
-        JobsLocker.Unlock();
-#else
-        if (!Jobs.try_dequeue(consumerToken, data))
-            data.Job.Unbind();
-#endif
+        const bool hasJob = DequeueJob(data, lowestPriority);
 #if JOB_SYSTEM_USE_STATS
         Platform::InterlockedIncrement(&DequeueCount);
         Platform::InterlockedAdd(&DequeueSum, Platform::GetTimeCycles() - start);
 #endif
 
-        if (data.Job.IsBinded())
+        if (hasJob)
         {
 #if USE_CSHARP
             // Ensure to have C# thread attached to this thead (late init due to MCore being initialized after Job System)
@@ -197,21 +461,7 @@ int32 JobSystemThread::Run()
 #endif
 
             // Run job
-            data.Job(data.Index);
-
-            // Move forward with the job queue
-            JobsLocker.Lock();
-            JobContext& context = JobContexts.At(data.JobKey);
-            if (Platform::InterlockedDecrement(&context.JobsLeft) <= 0)
-            {
-                ASSERT_LOW_LAYER(context.JobsLeft <= 0);
-                JobContexts.Remove(data.JobKey);
-            }
-            JobsLocker.Unlock();
-
-            WaitSignal.NotifyAll();
-
-            data.Job.Unbind();
+            RunJob(data);
         }
         else
         {
@@ -229,10 +479,9 @@ int32 JobSystemThread::Run()
 void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
 {
 #if JOB_SYSTEM_ENABLED
-    // TODO: disable async if called on job thread? or maybe Wait should handle waiting in job thread to do the processing?
     if (jobCount > 1)
     {
-        // Async
+        // Async (waiting thread helps with the jobs execution so it's safe to be used on a job thread)
         const int64 jobWaitHandle = Dispatch(job, jobCount);
         Wait(jobWaitHandle);
     }
@@ -245,7 +494,63 @@ void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
     }
 }
 
-int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
+void JobSystem::ParallelFor(int32 begin, int32 end, int32 grainSize, const Function<void(int32, int32)>& func)
+{
+    if (end <= begin)
+        return;
+#if JOB_SYSTEM_ENABLED
+    PROFILE_CPU();
+    int32 index = begin;
+    if (grainSize <= 0)
+    {
+        // Estimate the cost of a single item by running the first items on the calling thread (doubling the amount until the duration is measurable)
+        uint64 probeCycles = 0;
+        for (int32 probe = 1; index < end && probeCycles < JOB_SYSTEM_PARALLEL_FOR_PROBE_CYCLES; probe *= 2)
+        {
+            const int32 probeEnd = Math::Min(index + probe, end);
+            const uint64 start = Platform::GetTimeCycles();
+            func(index, probeEnd);
+            probeCycles += Platform::GetTimeCycles() - start;
+            index = probeEnd;
+        }
+        if (index == end)
+            return;
+
+        // Pick chunks big enough to hide the scheduling overhead but keep a few chunks per thread for a load balancing
+        const uint64 itemCycles = Math::Max<uint64>(probeCycles / (uint64)(index - begin), 1);
+        const int32 balancedGrainSize = (end - index) / Math::Max(ThreadsCount * 4, 1);
+        grainSize = (int32)Math::Min<uint64>(JOB_SYSTEM_PARALLEL_FOR_CHUNK_CYCLES / itemCycles, (uint64)balancedGrainSize);
+        grainSize = Math::Max(grainSize, 1);
+    }
+    const int32 chunksCount = (end - index + grainSize - 1) / grainSize;
+    if (chunksCount <= 1 || ThreadsCount <= 1)
+    {
+        // Sync
+        func(index, end);
+        return;
+    }
+
+    // Async (threads pick the next chunk of items until all are done)
+    volatile int64 next = index;
+    auto job = [&](int32)
+    {
+        while (true)
+        {
+            const int64 chunkStart = Platform::InterlockedAdd(&next, (int64)grainSize);
+            if (chunkStart >= end)
+                break;
+            func((int32)chunkStart, (int32)Math::Min<int64>(chunkStart + grainSize, end));
+        }
+    };
+    const int64 label = Dispatch(job, Math::Min(chunksCount - 1, ThreadsCount));
+    job(0);
+    Wait(label);
+#else
+    func(begin, end);
+#endif
+}
+
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount, JobPriority priority)
 {
     PROFILE_CPU();
     if (jobCount <= 0)
@@ -256,26 +561,16 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 #endif
     const auto label = Platform::InterlockedAdd(&JobLabel, (int64)jobCount) + jobCount;
 
-    JobData data;
-    data.Job = job;
-    data.JobKey = label;
-
-    JobContext context;
-    context.JobsLeft = jobCount;
-
-#if JOB_SYSTEM_USE_MUTEX
-    JobsLocker.Lock();
-    JobContexts.Add(label, context);
-    for (data.Index = 0; data.Index < jobCount; data.Index++)
-        Jobs.PushBack(data);
-    JobsLocker.Unlock();
-#else
-    JobsLocker.Lock();
+    ContextsLocker.Lock();
+    JobContext* context = JobContextsPool.HasItems() ? JobContextsPool.Pop() : New<JobContext>();
+    context->JobsLeft = jobCount;
+    context->Label = label;
+    context->Priority = priority;
+    context->Job = job;
     JobContexts.Add(label, context);
-    JobsLocker.Unlock();
-    for (data.Index = 0; data.Index < jobCount; data.Index++)
-        Jobs.enqueue(data);
-#endif
+    ContextsLocker.Unlock();
+
+    EnqueueJobs(context, jobCount);
 
 #if JOB_SYSTEM_USE_STATS
     LOG(Info, "Job enqueue time: {0} cycles", (int64)(Platform::GetTimeCycles() - start));
@@ -283,7 +578,8 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 
     if (JobStartingOnDispatch)
     {
-        if (jobCount == 1)
+        // Background jobs wake all threads as the one woken up could be the latency-critical lane
+        if (jobCount == 1 && priority != JobPriority::Background)
             JobsSignal.NotifyOne();
         else
             JobsSignal.NotifyAll();
@@ -300,20 +596,7 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 void JobSystem::Wait()
 {
 #if JOB_SYSTEM_ENABLED
-    JobsLocker.Lock();
-    int32 numJobs = JobContexts.Count();
-    JobsLocker.Unlock();
-
-    while (numJobs > 0)
-    {
-        WaitMutex.Lock();
-        WaitSignal.Wait(WaitMutex, 1);
-        WaitMutex.Unlock();
-
-        JobsLocker.Lock();
-        numJobs = JobContexts.Count();
-        JobsLocker.Unlock();
-    }
+    WaitJob(-1);
 #endif
 }
 
@@ -322,24 +605,7 @@ void JobSystem::Wait(int64 label)
 #if JOB_SYSTEM_ENABLED
     PROFILE_CPU();
 
-    while (Platform::AtomicRead(&ExitFlag) == 0)
-    {
-        JobsLocker.Lock();
-        const JobContext* context = JobContexts.TryGet(label);
-        JobsLocker.Unlock();
-
-        // Skip if context has been already executed (last job removes it)
-        if (!context)
-            break;
-
-        // Wait on signal until input label is not yet done
-        WaitMutex.Lock();
-        WaitSignal.Wait(WaitMutex, 1);
-        WaitMutex.Unlock();
-
-        // Wake up any thread to prevent stalling in highly multi-threaded environment
-        JobsSignal.NotifyOne();
-    }
+    WaitJob(label);
 
 #if JOB_SYSTEM_USE_STATS
     LOG(Info, "Job average dequeue time: {0} cycles", DequeueSum / DequeueCount);
@@ -355,14 +621,8 @@ void JobSystem::SetJobStartingOnDispatch(bool value)
 
     if (value)
     {
-#if JOB_SYSTEM_USE_MUTEX
-        JobsLocker.Lock();
-        const int32 count = Jobs.Count();
-        JobsLocker.Unlock();
-#else
-        const int32 count = Jobs.Count();
-#endif
-        if (count == 1)
+        const int32 count = GetJobsQueued();
+        if (count == 1 && Platform::AtomicRead(&JobsQueued[(int32)JobPriority::Background]) == 0)
             JobsSignal.NotifyOne();
         else if (count != 0)
             JobsSignal.NotifyAll();
@@ -378,3 +638,14 @@ int32 JobSystem::GetThreadsCount()
     return 0;
 #endif
 }
+
+int32 JobSystem::GetQueuedJobsCount(JobPriority priority)
+{
+#if JOB_SYSTEM_ENABLED
+    if ((uint32)priority >= (uint32)JobPriority::MAX)
+        return 0;
+    return (int32)Platform::AtomicRead(&JobsQueued[(int32)priority]);
+#else
+    return 0;
+#endif
+}
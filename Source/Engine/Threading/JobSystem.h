@@ -4,6 +4,30 @@
 
 #include "Engine/Core/Delegate.h"
 
+/// <summary>
+/// The priority of the jobs execution.
+/// </summary>
+API_ENUM() enum class JobPriority
+{
+    /// <summary>
+    /// The latency-critical work (eg. frame rendering). Executed before any other jobs.
+    /// </summary>
+    High = 0,
+
+    /// <summary>
+    /// The default priority.
+    /// </summary>
+    Normal = 1,
+
+    /// <summary>
+    /// The background work (eg. asynchronous data processing). Executed when there are no other jobs queued and never on the job thread dedicated for the latency-critical work.
+    /// </summary>
+    Background = 2,
+
+    API_ENUM(Attributes="HideInEditor")
+    MAX
+};
+
 /// <summary>
 /// Lightweight multi-threaded jobs execution scheduler. Uses a pool of threads and supports work-stealing concept.
 /// </summary>
@@ -18,21 +42,31 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// <param name="jobCount">The job executions count.</param>
     API_FUNCTION() static void Execute(const Function<void(int32)>& job, int32 jobCount = 1);
 
+    /// <summary>
+    /// Executes the function over the range of items split into chunks that are processed in parallel (utility to call dispatch and wait for the end). The calling thread participates in the processing.
+    /// </summary>
+    /// <param name="begin">The index of the first item (inclusive).</param>
+    /// <param name="end">The index of the last item (exclusive).</param>
+    /// <param name="grainSize">The amount of items to process in a single chunk. Use 0 to pick it automatically based on the threads count and the measured cost of the first items.</param>
+    /// <param name="func">The function. Arguments are the index of the first item (inclusive) and the index of the last item (exclusive) of the chunk.</param>
+    static void ParallelFor(int32 begin, int32 end, int32 grainSize, const Function<void(int32, int32)>& func);
+
     /// <summary>
     /// Dispatches the job for the execution.
     /// </summary>
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
+    /// <param name="priority">The jobs execution priority.</param>
     /// <returns>The label identifying this dispatch. Can be used to wait for the execution end.</returns>
-    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount = 1);
+    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount = 1, JobPriority priority = JobPriority::Normal);
 
     /// <summary>
-    /// Waits for all dispatched jobs to finish.
+    /// Waits for all dispatched jobs to finish. The calling thread executes the queued jobs while waiting.
     /// </summary>
     API_FUNCTION() static void Wait();
 
     /// <summary>
-    /// Waits for all dispatched jobs until a given label to finish (i.e. waits for a Dispatch that returned that label).
+    /// Waits for all dispatched jobs until a given label to finish (i.e. waits for a Dispatch that returned that label). The calling thread executes the queued jobs while waiting so it can be used within a job (nested parallelism).
     /// </summary>
     /// <param name="label">The label.</param>
     API_FUNCTION() static void Wait(int64 label);
@@ -46,4 +80,10 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// Gets the amount of job system threads.
     /// </summary>
     API_PROPERTY() static int32 GetThreadsCount();
+
+    /// <summary>
+    /// Gets the amount of jobs waiting in the queue of a given priority (jobs that are being executed are not included).
+    /// </summary>
+    /// <param name="priority">The jobs priority.</param>
+    API_FUNCTION() static int32 GetQueuedJobsCount(JobPriority priority);
 };
@@ -2,15 +2,11 @@
 
 #include "TaskGraph.h"
 #include "JobSystem.h"
-#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 
 namespace
 {
-    bool SortTaskGraphSystem(TaskGraphSystem* const& a, TaskGraphSystem* const& b)
-    {
-        return b->Order > a->Order;
-    };
+    THREADLOCAL TaskGraphSystem* CurrentSystem = nullptr;
 }
 
 TaskGraphSystem::TaskGraphSystem(const SpawnParams& params)
@@ -79,55 +75,65 @@ void TaskGraph::Execute()
 {
     PROFILE_CPU();
 
-    for (auto system : _systems)
-        system->PreExecute(this);
-
+    // Prepare systems (async ones in parallel on job threads)
     _queue.Clear();
-    _remaining.Clear();
-    _remaining.Add(_systems);
+    for (auto system : _systems)
+    {
+        if (system->AsyncExecute)
+            _queue.Add(system);
+        else
+            system->PreExecute(this);
+    }
+    if (_queue.HasItems())
+    {
+        JobSystem::Execute([this](int32 i)
+        {
+            _queue[i]->PreExecute(this);
+        }, _queue.Count());
+        _queue.Clear();
+    }
 
-    while (_remaining.HasItems())
+    // Start systems without dependencies (others are started once all of their dependencies are done)
+    _labels.Clear();
+    for (auto system : _systems)
     {
-        // Find systems without dependencies or with already executed dependencies
-        for (int32 i = _remaining.Count() - 1; i >= 0; i--)
+        int64 dependencies = 0;
+        for (auto d : system->_dependencies)
         {
-            auto e = _remaining[i];
-            bool hasReadyDependencies = true;
-            for (auto d : e->_dependencies)
-            {
-                if (_remaining.Contains(d))
-                {
-                    hasReadyDependencies = false;
-                    break;
-                }
-            }
-            if (hasReadyDependencies)
-            {
-                _queue.Add(e);
-                _remaining.RemoveAt(i);
-            }
+            if (_systems.Contains(d))
+                dependencies++;
         }
+        system->_dependenciesLeft = dependencies;
+    }
+    for (auto system : _systems)
+    {
+        if (system->_dependenciesLeft == 0)
+            StartSystem(system);
+    }
 
-        // End if no systems left
-        if (_queue.IsEmpty())
-            break;
-
-        // Execute in order
-        Sorting::QuickSort(_queue.Get(), _queue.Count(), &SortTaskGraphSystem);
-        JobSystem::SetJobStartingOnDispatch(false);
-        _labels.Clear();
-        for (int32 i = 0; i < _queue.Count(); i++)
+    // Execute systems that run on the main thread once they're ready and wait for the async work (systems with cyclic dependencies are skipped)
+    while (true)
+    {
+        TaskGraphSystem* system = nullptr;
+        int64 label = 0;
+        _locker.Lock();
+        if (_queue.HasItems())
         {
-            _currentSystem = _queue[i];
-            _currentSystem->Execute(this);
+            system = _queue[0];
+            _queue.RemoveAtKeepOrder(0);
         }
-        _currentSystem = nullptr;
-        _queue.Clear();
-
-        // Wait for async jobs to finish
-        JobSystem::SetJobStartingOnDispatch(true);
-        for (const int64 label : _labels)
+        else if (_labels.HasItems())
+        {
+            label = _labels[0];
+            _labels.RemoveAtKeepOrder(0);
+        }
+        _locker.Unlock();
+        if (system)
+            ExecuteSystem(system);
+        else if (label)
             JobSystem::Wait(label);
+        else
+            break;
     }
 
     for (auto system : _systems)
@@ -136,7 +142,67 @@ void TaskGraph::Execute()
 
 void TaskGraph::DispatchJob(const Function<void(int32)>& job, int32 jobCount)
 {
-    ASSERT(_currentSystem);
-    const int64 label = JobSystem::Dispatch(job, jobCount);
+    TaskGraphSystem* system = CurrentSystem;
+    ASSERT(system);
+    if (jobCount <= 0)
+        return;
+    Platform::InterlockedAdd(&system->_jobsLeft, jobCount);
+    const int64 label = JobSystem::Dispatch([this, system, job](int32 i)
+    {
+        job(i);
+        OnSystemJobDone(system);
+    }, jobCount);
+    _locker.Lock();
     _labels.Add(label);
+    _locker.Unlock();
+}
+
+void TaskGraph::StartSystem(TaskGraphSystem* system)
+{
+    if (system->AsyncExecute)
+    {
+        const int64 label = JobSystem::Dispatch([this, system](int32)
+        {
+            ExecuteSystem(system);
+        });
+        _locker.Lock();
+        _labels.Add(label);
+        _locker.Unlock();
+    }
+    else
+    {
+        // Keep the main thread queue sorted by the execution order
+        _locker.Lock();
+        int32 index = 0;
+        while (index < _queue.Count() && _queue[index]->Order <= system->Order)
+            index++;
+        _queue.Insert(index, system);
+        _locker.Unlock();
+    }
+}
+
+void TaskGraph::ExecuteSystem(TaskGraphSystem* system)
+{
+    // System is done when Execute ends and all jobs dispatched by it finish
+    system->_jobsLeft = 1;
+
+    // Restore the previous system after the call (waits inside Execute can run other systems on this thread)
+    TaskGraphSystem* prevSystem = CurrentSystem;
+    CurrentSystem = system;
+    system->Execute(this);
+    CurrentSystem = prevSystem;
+    OnSystemJobDone(system);
+}
+
+void TaskGraph::OnSystemJobDone(TaskGraphSystem* system)
+{
+    if (Platform::InterlockedDecrement(&system->_jobsLeft) != 0)
+        return;
+
+    // Start dependant systems that have all dependencies done
+    for (auto e : system->_reverseDependencies)
+    {
+        if (_systems.Contains(e) && Platform::InterlockedDecrement(&e->_dependenciesLeft) == 0)
+            StartSystem(e);
+    }
 }
@@ -4,6 +4,7 @@
 
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/CriticalSection.h"
 
 class TaskGraph;
 
@@ -17,6 +18,8 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
 private:
     Array<TaskGraphSystem*, InlinedAllocation<16>> _dependencies;
     Array<TaskGraphSystem*, InlinedAllocation<16>> _reverseDependencies;
+    volatile int64 _dependenciesLeft = 0;
+    volatile int64 _jobsLeft = 0;
 
 public:
     /// <summary>
@@ -24,6 +27,11 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
     /// </summary>
     API_FIELD() int32 Order = 0;
 
+    /// <summary>
+    /// If checked, the system's PreExecute and Execute methods can be called on a job thread (in parallel with other systems), otherwise they are called on the main thread.
+    /// </summary>
+    API_FIELD() bool AsyncExecute = false;
+
 public:
     ~TaskGraphSystem();
 
@@ -66,10 +74,9 @@ API_CLASS() class FLAXENGINE_API TaskGraph : public ScriptingObject
 DECLARE_SCRIPTING_TYPE(TaskGraph);
 private:
     Array<TaskGraphSystem*, InlinedAllocation<64>> _systems;
-    Array<TaskGraphSystem*, InlinedAllocation<64>> _remaining;
     Array<TaskGraphSystem*, InlinedAllocation<64>> _queue;
     Array<int64, InlinedAllocation<64>> _labels;
-    TaskGraphSystem* _currentSystem = nullptr;
+    CriticalSection _locker;
 
 public:
     /// <summary>
@@ -90,7 +97,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraph);
     API_FUNCTION() void RemoveSystem(TaskGraphSystem* system);
 
     /// <summary>
-    /// Schedules the asynchronous systems execution including ordering and dependencies handling.
+    /// Schedules the asynchronous systems execution including ordering and dependencies handling. Each system is executed as soon as all jobs of its dependencies are done.
     /// </summary>
     API_FUNCTION() void Execute();
 
@@ -101,4 +108,9 @@ DECLARE_SCRIPTING_TYPE(TaskGraph);
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
     API_FUNCTION() void DispatchJob(const Function<void(int32)>& job, int32 jobCount = 1);
+
+private:
+    void StartSystem(TaskGraphSystem* system);
+    void ExecuteSystem(TaskGraphSystem* system);
+    void OnSystemJobDone(TaskGraphSystem* system);
 };
@@ -228,7 +228,8 @@ bool ModelTool::GenerateModelSDF(Model* inputModel, ModelData* modelData, float
             }
         }
     };
-    JobSystem::Execute(sdfJob, resolution.Z);
+    // SDF baking is a low-priority work so it runs as background jobs (the waiting thread helps with them)
+    JobSystem::Wait(JobSystem::Dispatch(sdfJob, resolution.Z, JobPriority::Background));
 
     // Cache SDF data on a CPU
     if (outputStream)
@@ -294,7 +295,7 @@ bool ModelTool::GenerateModelSDF(Model* inputModel, ModelData* modelData, float
                 }
             }
         };
-        JobSystem::Execute(mipJob, resolutionMip.Z);
+        JobSystem::Wait(JobSystem::Dispatch(mipJob, resolutionMip.Z, JobPriority::Background));
 
         // Cache SDF data on a CPU
         if (outputStream)
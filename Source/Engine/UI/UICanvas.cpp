@@ -39,6 +39,7 @@ MMethod* UICanvas_ParentChanged = nullptr;
 UICanvas::UICanvas(const SpawnParams& params)
     : Actor(params)
 {
+    Flags |= ObjectFlags::NoAsyncDeserialize; // Calls the managed UI code when linked to the parent
 #if !COMPILE_WITHOUT_CSHARP
     Platform::MemoryBarrier();
     if (UICanvas_Serialize == nullptr)
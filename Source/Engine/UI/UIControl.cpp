@@ -37,6 +37,7 @@ MMethod* UIControl_EndPlay = nullptr;
 UIControl::UIControl(const SpawnParams& params)
     : Actor(params)
 {
+    Flags |= ObjectFlags::NoAsyncDeserialize; // Calls the managed UI code when linked to the parent
 #if !COMPILE_WITHOUT_CSHARP
     Platform::MemoryBarrier();
     if (UIControl_Serialize == nullptr)